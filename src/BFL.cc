@@ -1,40 +1,57 @@
 #include "BFL.h"
 
-void depth_first_search_visit(node const& n, LabelDiscovery& label_discover, LabelFinish& label_finish, std::vector<node const*>& post_order, long& current, long& order_index) {
-    label_discover[n.id_] = ++current;
-    for (auto const e : n.outgoing_edges_) {
-        if (label_discover[e->id_] != 0) continue; // if e was visited
+#include <limits>
+#include <stdexcept>
 
-        depth_first_search_visit(*e, label_discover, label_finish, post_order, current, order_index);
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
+
+template <typename Graph>
+void depth_first_search_visit(Graph const& g, node_index const n, interval* intervals, std::vector<node_index>& post_order, long& current, long& order_index) {
+    intervals[n].discovery_ = ++current;
+    for (auto const e : successors(g, n)) {
+        if (intervals[e].discovery_ != 0) continue; // if e was visited
+
+        depth_first_search_visit(g, e, intervals, post_order, current, order_index);
     }
-    post_order[order_index++] = &n;
-    label_finish[n.id_] = ++current;
+    post_order[order_index++] = n;
+    intervals[n].finish_ = ++current;
 }
 
-std::tuple<std::vector<node const*>, LabelDiscovery, LabelFinish> depth_first_search(graph const& g) {
-    LabelDiscovery label_discovery(g.nodes_.size());
-    LabelFinish label_finish(g.nodes_.size());
-    std::vector<node const*> post_order(g.nodes_.size());
+template <typename Graph>
+std::vector<node_index> depth_first_search(Graph const& g, interval* intervals) {
+    auto const num_of_nodes = number_of_nodes(g);
+    // the intervals go up to 2 * num_of_nodes
+    if(2 * static_cast<unsigned long long>(num_of_nodes) > std::numeric_limits<node_index>::max()) {
+        throw std::invalid_argument( "the input graph has too many nodes for the configured node_index" );
+    }
+    std::vector<node_index> post_order(num_of_nodes);
     long current = 0; // keeps track of the current step for the label_discovery and label_finish
     long order_index = 0;
 
     // start DFS on all nodes without incoming edges
-    for(auto const& n : g.nodes_) {
-        if(n.incoming_edges_.empty()) {
-            depth_first_search_visit(n, label_discovery, label_finish, post_order, current, order_index);
+    for(long n = 0; n < num_of_nodes; ++n) {
+        if(in_degree(g, n) == 0) {
+            depth_first_search_visit(g, n, intervals, post_order, current, order_index);
         }
     }
 
-    if(order_index < g.nodes_.size() - 1) {
+    if(order_index < num_of_nodes - 1) {
         throw std::invalid_argument( "the input graph is not a dag" );
     }
 
-    return std::make_tuple(post_order, label_discovery, label_finish);
+    return post_order;
 }
 
-std::vector<node const*> merge_vertices(std::vector<node const*> const& post_order, long const d) {
+template std::vector<node_index> depth_first_search(graph const&, interval*);
+template std::vector<node_index> depth_first_search(csr_graph const&, interval*);
+template std::vector<node_index> depth_first_search(slab_graph const&, interval*);
+template std::vector<node_index> depth_first_search(compressed_graph const&, interval*);
+
+std::vector<node_index> merge_vertices(std::vector<node_index> const& post_order, long const d) {
     auto const num_of_intervals = std::min(d, static_cast<long>(post_order.size()));
-    std::vector<const node*> g(post_order.size());
+    std::vector<node_index> g(post_order.size());
 
     // Calculate the width of each interval
     long interval_width = std::max(static_cast<long>(post_order.size()) / num_of_intervals, 1l);
@@ -50,7 +67,7 @@ std::vector<node const*> merge_vertices(std::vector<node const*> const& post_ord
 
     for(long i = 0; i < num_of_intervals; ++i) {
         for(long j = lower_bounds[i]; j < lower_bounds[i+1]; ++j) {
-            g[post_order[j]->id_] = post_order[lower_bounds[i]];
+            g[post_order[j]] = post_order[lower_bounds[i]];
         }
     }
 
@@ -1,8 +1,14 @@
 #pragma once
 #include "graphs.h"
+#include "intervalLabelings.h"
+#include "labelArena.h"
+#include "labelBuckets.h"
+#include "orderFilters.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
 
 #include <bitset>
-#include <functional>
+#include <concepts>
 #include <utility>
 #include <iostream>
 #include <unordered_set>
@@ -10,104 +16,156 @@
 
 using namespace graphs;
 
-template <size_t hash_range>
-using LabelIn = std::vector<std::bitset<hash_range>>;
-
-template <size_t hash_range>
-using LabelOut = std::vector<std::bitset<hash_range>>;
-
-using LabelDiscovery = std::vector<long>;
-using LabelFinish = std::vector<long>;
-
-template <size_t hash_range>
+template <size_t hash_range, typename Graph = graph>
 struct labeled_graph {
-    graph& graph_;
-    LabelDiscovery label_discovery_;
-    LabelFinish label_finish_;
-    LabelIn<hash_range> label_in_;
-    LabelOut<hash_range> label_out_;
-
-    labeled_graph(graph& graph, LabelDiscovery label_discovery, LabelFinish label_finish, LabelIn<hash_range> label_in, LabelOut<hash_range> label_out)
-        : graph_(graph), label_discovery_(std::move(label_discovery)), label_finish_(std::move(label_finish)), label_in_(label_in), label_out_(label_out) {}
+    Graph const& graph_;
+    label_arena<hash_range> labels_;
+    interval_field_view label_discovery_;
+    interval_field_view label_finish_;
+    label_view<hash_range> label_in_;
+    label_view<hash_range> label_out_;
+    interval_labelings interval_labelings_; // additional interval labelings, empty unless build_labeled_graph is asked for some
+    order_filters order_filters_;
+
+    // the labels are zeroed and get filled in place by build_labeled_graph
+    explicit labeled_graph(Graph const& graph)
+        : graph_(graph), labels_(number_of_nodes(graph)), label_discovery_{labels_.intervals_, &interval::discovery_}, label_finish_{labels_.intervals_, &interval::finish_},
+          label_in_{labels_.label_in_}, label_out_{labels_.label_out_} {}
 };
 
-std::tuple<std::vector<node const*>, LabelDiscovery, LabelFinish> depth_first_search(graph const& g);
-
-std::vector<node const*> merge_vertices(std::vector<node const*> const& post_order, long d);
-
-template <size_t hash_range>
-void compute_label_out(graph const& graph, std::vector<node const*> const& g, std::function<long(node const*)> const& h, node const& n, std::vector<std::bitset<hash_range>>& label_out) {
-    label_out[n.id_].set(h(g[n.id_]));
-    for(auto const successor : n.outgoing_edges_) {
-        if(label_out[successor->id_].none()) { // if successor has not been visited
-            compute_label_out<hash_range>(graph, g, h, *successor, label_out);
+// Graph can be any graph representation that provides number_of_nodes, successors and predecessors (e.g. graph or csr_graph)
+// writes the DFS interval of each node into intervals (which need to be zeroed) and returns the post order
+template <typename Graph>
+std::vector<node_index> depth_first_search(Graph const& g, interval* intervals);
+
+template <size_t hash_range, typename Graph>
+void compute_label_out(Graph const& graph, bucket_array const& buckets, node_index const n, label_arena<hash_range> const& labels) {
+    set_label_bit<hash_range>(labels.out(n), buckets[n]);
+    for(auto const successor : successors(graph, n)) {
+        if(label_is_empty<hash_range>(labels.out(successor))) { // if successor has not been visited
+            compute_label_out<hash_range>(graph, buckets, successor, labels);
         }
-        label_out[n.id_] |= label_out[successor->id_]; // label_out[n] = label_out[n] union label_out[successor]
+        unite_labels<hash_range>(labels.out(n), labels.out(successor)); // label_out[n] = label_out[n] union label_out[successor]
     }
 }
 
-template <size_t hash_range>
-void compute_label_in(graph const& graph, std::vector<node const*> const& g, std::function<long(node const*)> const& h, node const& n, LabelIn<hash_range>& label_in) {
-    label_in[n.id_].set(h(g[n.id_]));
-    for(auto const predecessor : n.incoming_edges_) {
-        if(label_in[predecessor->id_].none()) { // if successor has not been visited
-            compute_label_in<hash_range>(graph, g, h, *predecessor, label_in);
+template <size_t hash_range, typename Graph>
+void compute_label_in(Graph const& graph, bucket_array const& buckets, node_index const n, label_arena<hash_range> const& labels) {
+    set_label_bit<hash_range>(labels.in(n), buckets[n]);
+    for(auto const predecessor : predecessors(graph, n)) {
+        if(label_is_empty<hash_range>(labels.in(predecessor))) { // if successor has not been visited
+            compute_label_in<hash_range>(graph, buckets, predecessor, labels);
         }
-        label_in[n.id_] |= label_in[predecessor->id_]; // label_in[n] = label_in[n] union label_in[predecessor]
+        unite_labels<hash_range>(labels.in(n), labels.in(predecessor)); // label_in[n] = label_in[n] union label_in[predecessor]
     }
 }
 
-// the hash should map to values in a range from 0...hash_range-1
-template <size_t hash_range> // the range is the number of values that can be possible outputs of the hash function
-labeled_graph<hash_range> build_labeled_graph(graph& graph, std::function<long(node const*)> const& h, long const d) {
-    LabelIn<hash_range> label_in(graph.nodes_.size());
-    LabelOut<hash_range> label_out(graph.nodes_.size());
-
-    auto [post_order, label_discovery, label_finish] = depth_first_search(graph);
+// fills the labels of labeled, whose intervals were written by the DFS that returned post_order, with the given buckets
+template <size_t hash_range, typename Graph>
+void compute_labels(labeled_graph<hash_range, Graph>& labeled, std::vector<node_index> const& post_order, bucket_array const& buckets, long const number_of_interval_labelings) {
+    auto const& graph = labeled.graph_;
+    auto const& labels = labeled.labels_;
 
-    auto g = merge_vertices(post_order, d);
+    // the reverse post order of the DFS is a topological order
+    labeled.order_filters_ = build_order_filters(graph, std::vector<node_index>(post_order.rbegin(), post_order.rend()));
 
     for(auto n : post_order) {
-        if(label_out[n->id_].none()) {
-            compute_label_out<hash_range>(graph, g, h, *n, label_out);
+        if(label_is_empty<hash_range>(labels.out(n))) {
+            compute_label_out<hash_range>(graph, buckets, n, labels);
         }
-        if(label_in[n->id_].none()) {
-            compute_label_in<hash_range>(graph, g, h, *n, label_in);
+        if(label_is_empty<hash_range>(labels.in(n))) {
+            compute_label_in<hash_range>(graph, buckets, n, labels);
         }
     }
 
-    return labeled_graph<hash_range>(graph, label_discovery, label_finish, label_in, label_out);
+    if(number_of_interval_labelings > 0) {
+        labeled.interval_labelings_ = build_interval_labelings(graph, number_of_interval_labelings);
+    }
 }
 
-template <size_t hash_range>
-bool query_reachability(const labeled_graph<hash_range>& graph, const node& u, const node& v) {
-    std::vector<bool> visited(graph.graph_.nodes_.size(), false);
-    return query_reachability<hash_range>(graph, u, v, visited);
+// the policy (or the bucket_assignment that names one) assigns the buckets of the (merged) nodes in a range from 0...hash_range-1, see assign_buckets
+// number_of_interval_labelings is the number of GRAIL labelings that are built in addition to the interval of the labels
+template <size_t hash_range, typename Graph, bucket_source Buckets> // the range is the number of values that can be possible outputs of the hash function
+labeled_graph<hash_range, Graph> build_labeled_graph(Graph const& graph, Buckets const& policy, long const d, long const number_of_interval_labelings = 0) {
+    labeled_graph<hash_range, Graph> labeled(graph);
+    auto const post_order = depth_first_search(graph, labeled.labels_.intervals_);
+    compute_labels(labeled, post_order, assign_buckets<hash_range>(post_order, d, policy), number_of_interval_labelings);
+    return labeled;
 }
 
-template <size_t hash_range>
-bool query_reachability(labeled_graph<hash_range> const& graph, node const& u, node const& v, std::vector<bool>& visited) {
-    // ReachabilityLogger::getInstance().increment_with_dfs();
-    visited[u.id_] = true;
+// the hash should map to values in a range from 0...hash_range-1
+template <size_t hash_range, typename Hash> requires std::invocable<Hash const&, node const*> // the range is the number of values that can be possible outputs of the hash function
+labeled_graph<hash_range> build_labeled_graph(graph const& graph, Hash const& h, long const d, long const number_of_interval_labelings = 0) {
+    return build_labeled_graph<hash_range, graphs::graph>(graph, [&graph, &h](node_index const id) { return static_cast<long>(h(&graph.nodes_[id])); }, d, number_of_interval_labelings);
+}
 
-    if(graph.label_discovery_[u.id_] <= graph.label_discovery_[v.id_] && graph.label_finish_[v.id_] <= graph.label_finish_[u.id_]) {
+// the cheap interval and order checks are done before the subset tests of the labels
+template <size_t hash_range, typename Graph>
+label_answer check_labels(labeled_graph<hash_range, Graph> const& graph, node_index const n, node_index const v) {
+    auto const& labels = graph.labels_;
+    if(labels.intervals_[n].discovery_ <= labels.intervals_[v].discovery_ && labels.intervals_[v].finish_ <= labels.intervals_[n].finish_) {
         // std::cout << "reachability confirmed by label_discovery and label_finish" << std::endl;
-        return true;
+        return label_answer::reachable;
+    }
+    if(auto const& bounds = graph.order_filters_.bounds_; !bounds.empty() && check_order_filters(bounds[n], bounds[v]) != order_filter::none) {
+        return label_answer::unreachable;
+    }
+    if(auto const answer = check_interval_labelings(graph.interval_labelings_, n, v); answer != 0) {
+        return answer > 0 ? label_answer::reachable : label_answer::unreachable;
     }
-    // if L_out(v) !subset_of L_out(u) or L_in(u) !subset_of L_in(v)
-    if((graph.label_out_[v.id_] & graph.label_out_[u.id_]) != graph.label_out_[v.id_]
-        || (graph.label_in_[u.id_] & graph.label_in_[v.id_]) != graph.label_in_[u.id_]) {
+    // if L_out(v) !subset_of L_out(n) or L_in(n) !subset_of L_in(v)
+    if(!labels_are_subsets<hash_range>(labels.out(v), labels.out(n), labels.in(n), labels.in(v))) {
         // std::cout << "reachability denied by label_in and label_out" << std::endl;
-        return false;
+        return label_answer::unreachable;
     }
-    for (auto const w : u.outgoing_edges_) {
-        if (visited[w->id_]) continue;
+    return label_answer::unknown;
+}
 
-        if (query_reachability<hash_range>(graph, *w, v, visited)) {
-            // std::cout << "reachability confirmed by a (possibly) early stopped DFS" << std::endl;
-            return true;
-        }
+// the DFS interval of node n, its width grows with the number of nodes below n in the DFS tree
+template <size_t hash_range, typename Graph>
+interval const& dfs_interval(labeled_graph<hash_range, Graph> const& graph, node_index const n) {
+    return graph.labels_.intervals_[n];
+}
+
+// prefetches everything check_labels reads of node n
+template <size_t hash_range, typename Graph>
+void prefetch_labels(labeled_graph<hash_range, Graph> const& graph, node_index const n) {
+    __builtin_prefetch(graph.labels_.intervals_ + n);
+    __builtin_prefetch(graph.order_filters_.bounds_.data() + n);
+    if(graph.interval_labelings_.k_ > 0) __builtin_prefetch(graph.interval_labelings_.of(n));
+    prefetch_label<hash_range>(graph.labels_.out(n));
+    prefetch_label<hash_range>(graph.labels_.in(n));
+}
+
+// the backward search of a bidirectional query prunes a node n with check_labels(graph, u, n), i.e. with label_in and the intervals
+template <size_t hash_range, typename Graph>
+bool query_reachability(labeled_graph<hash_range, Graph> const& graph, node_index const u, node_index const v, query_context& context,
+                        search_direction const direction = search_direction::forward) {
+    auto const resolved = resolve_search_direction(graph.graph_, u, v, direction);
+    if(resolved == search_direction::bidirectional) context.begin_bidirectional_query(number_of_nodes(graph.graph_));
+    else context.begin_query(number_of_nodes(graph.graph_));
+    if(auto const& bounds = graph.order_filters_.bounds_; !bounds.empty()) {
+        auto const filter = check_order_filters(bounds[u], bounds[v]);
+        context.counters_.count(filter);
+        if(filter != order_filter::none) return false;
     }
-    // std::cout << "reachability denied by a (possibly) early stopped DFS" << std::endl;
-    return false;
-}
\ No newline at end of file
+    // ReachabilityLogger::getInstance().increment_with_dfs();
+    auto const check = [&graph, v](node_index const n) { return check_labels(graph, n, v); };
+    auto const prefetch = [&graph](node_index const n) { prefetch_labels(graph, n); };
+    if(resolved == search_direction::bidirectional) {
+        return search_reachability_bidirectional(graph.graph_, u, v, context, check,
+            [&graph, u](node_index const n) { return check_labels(graph, u, n); }, prefetch);
+    }
+    return search_reachability(graph.graph_, u, context, check, prefetch);
+}
+
+// uses a context of the calling thread, so repeated queries do not allocate and clear a visited array
+template <size_t hash_range, typename Graph>
+bool query_reachability(labeled_graph<hash_range, Graph> const& graph, node_index const u, node_index const v, search_direction const direction = search_direction::forward) {
+    return query_reachability<hash_range>(graph, u, v, thread_query_context(), direction);
+}
+
+template <size_t hash_range>
+bool query_reachability(labeled_graph<hash_range> const& graph, node const& u, node const& v) {
+    return query_reachability<hash_range>(graph, u.id_, v.id_);
+}
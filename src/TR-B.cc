@@ -3,7 +3,8 @@
 #include <algorithm>
 
 #include "BFL.h"
-#include "MurmurHash3.h"
+#include "labelTuning.h"
+#include "memoryPolicy.h"
 
 std::vector<Edge> sort_edge(graph& graph) {
     std::vector<Edge> queue;
@@ -31,15 +32,37 @@ bool is_redundant(labeled_graph<hash_range> const& labeled_graph, Edge const& ed
 }
 
 // Algorithm 1 TR-B
-void tr_b(graph& graph) {
-    auto const hash_range = 1024;
-    auto const labeled_graph = build_labeled_graph<hash_range>(graph, [](node const* n) { return hash_in_range(n->id_, hash_range); }, hash_range*10);
-
+void tr_b(graph& graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
     auto queue = sort_edge(graph);
 
-    for(auto edge : queue) {
-        if(is_redundant(labeled_graph, edge)) {
-            graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+    with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        auto const labeled_graph = build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_);
+
+        for(auto edge : queue) {
+            if(is_redundant(labeled_graph, edge)) {
+                graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+            }
         }
-    }
+    });
+}
+
+void tr_b(graph& graph) {
+    tr_b(graph, label_parameters{});
+}
+
+// Algorithm 1 TR-B
+csr_graph tr_b(csr_graph const& graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph);
+    return with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        return tr_b(graph, build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_));
+    });
+}
+
+csr_graph tr_b(csr_graph const& graph) {
+    return tr_b(graph, label_parameters{});
 }
@@ -1,6 +1,59 @@
+#pragma once
 #include "graphs.h"
+#include "csrGraph.h"
+#include "labelParameters.h"
+#include "memoryPolicy.h"
+#include "reachabilityOracle.h"
+
+#include <type_traits>
 
 using namespace graphs;
 
 // Algorithm 1 TR-B
 void tr_b(graph& graph);
+
+// the labels are built with the given parameters instead of hash_range 1024
+void tr_b(graph& graph, label_parameters const& parameters);
+
+// Algorithm 1 TR-B on an immutable csr_graph, returns the transitive reduction as a new csr_graph
+csr_graph tr_b(csr_graph const& graph);
+
+csr_graph tr_b(csr_graph const& graph, label_parameters const& parameters);
+
+// returns whether u reaches v without the edge (u, v)
+template <reachability_oracle Oracle>
+bool is_redundant(Oracle const& oracle, node_index const u, node_index const v) {
+    // check weather any of the outgoing edges from u can reach v
+    for(auto const w : successors(oracle.graph_, u)) {
+        if(w == v) continue;
+        if(query_reachability(oracle, w, v)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Algorithm 1 TR-B with the given reachability oracle of graph instead of BFL labels
+template <reachability_oracle Oracle>
+csr_graph tr_b(csr_graph const& graph, Oracle const& oracle) {
+    // the graph is never changed, so removed edges are only marked by their position in graph.targets_out_
+    std::vector<bool> removed(graph.number_of_edges(), false);
+
+    for(long u = 0; u < graph.number_of_nodes(); ++u) {
+        for(auto i = graph.offsets_out_[u]; i < graph.offsets_out_[u+1]; ++i) {
+            if(is_redundant(oracle, u, graph.targets_out_[i])) {
+                removed[i] = true;
+            }
+        }
+    }
+
+    return remove_edges(graph, removed);
+}
+
+// the oracle is built by make_oracle(graph), e.g. tr_b(graph, [](csr_graph const& g) { return closure_oracle(g); })
+template <typename MakeOracle> requires reachability_oracle<std::invoke_result_t<MakeOracle const&, csr_graph const&>>
+csr_graph tr_b(csr_graph const& graph, MakeOracle const& make_oracle) {
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph);
+    return tr_b(graph, make_oracle(graph));
+}
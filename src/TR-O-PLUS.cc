@@ -3,7 +3,7 @@
 #include <unordered_set>
 
 #include "dagUtil.h"
-#include "MurmurHash3.h"
+#include "labelTuning.h"
 
 struct up_down_node {
     node* node_;
@@ -13,7 +13,7 @@ struct up_down_node {
     up_down_node(node* node, bool const is_up, size_t const degree) : node_(node), is_up_(is_up), degree(degree) {}
 };
 
-std::vector<Edge> sort_edge_tro_plus(graph& graph, std::vector<long> const& to) {
+std::vector<Edge> sort_edge_tro_plus(graph& graph, std::vector<node_index> const& to) {
     set_edges_in_topological_order(graph, to); // add sorting into topological order
 
     std::vector<Edge> queue;
@@ -56,8 +56,141 @@ std::vector<Edge> sort_edge_tro_plus(graph& graph, std::vector<long> const& to)
     return std::move(queue);
 }
 
+// returns the position of the edge (u, v) in graph.targets_out_, the outgoing edges need to be sorted in topological order
+long long edge_position(csr_graph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to) {
+    auto const outgoing_edges = graph.outgoing_edges(u);
+    auto const it = std::lower_bound(outgoing_edges.begin(), outgoing_edges.end(), v, [&to](node_index const a, node_index const b) { return to[a] < to[b]; });
+    return graph.offsets_out_[u] + (it - outgoing_edges.begin());
+}
+
+// the queue contains each edge as its source and its position in graph.targets_out_
+std::vector<std::tuple<node_index, long long>> sort_edge_tro_plus(csr_graph const& graph, std::vector<node_index> const& to) {
+    std::vector<std::tuple<node_index, long long>> queue;
+    queue.reserve(graph.number_of_edges());
+
+    std::vector<std::tuple<node_index, bool, long>> up_and_down_nodes; // (node, is_up, degree)
+    up_and_down_nodes.reserve(graph.number_of_nodes()*2);
+    // divide nodes into UP-nodes and DOWN-nodes
+    for (long n = 0; n < graph.number_of_nodes(); ++n) {
+        up_and_down_nodes.emplace_back(n, true, in_degree(graph, n));
+        up_and_down_nodes.emplace_back(n, false, out_degree(graph, n));
+    }
+    // sort up and down nodes by their degree in ascending order
+    std::sort(up_and_down_nodes.begin(), up_and_down_nodes.end(), [](auto const& a, auto const& b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+
+    std::vector<bool> handled_edges(graph.number_of_edges(), false);
+
+    for(auto const& [n, is_up, degree] : up_and_down_nodes) {
+        if(is_up) {
+            for (auto const incoming_node : graph.incoming_edges(n)) { // loop in descending order through incoming_edges
+                auto const position = edge_position(graph, incoming_node, n, to);
+                if (!handled_edges[position]) {
+                    handled_edges[position] = true;
+                    queue.emplace_back(incoming_node, position);
+                }
+            }
+        } else {
+            for (auto position = graph.offsets_out_[n]; position < graph.offsets_out_[n+1]; ++position) { // loop in ascending order through outgoing_edges
+                if (!handled_edges[position]) {
+                    handled_edges[position] = true;
+                    queue.emplace_back(n, position);
+                }
+            }
+        }
+    }
+
+    return queue;
+}
+
+// the queue contains each edge as its outgoing position in graph.slab_
+std::vector<long long> sort_edge_tro_plus(slab_graph const& graph) {
+    std::vector<long long> queue;
+    queue.reserve(graph.number_of_edges_);
+
+    std::vector<std::tuple<node_index, bool, long>> up_and_down_nodes; // (node, is_up, degree)
+    up_and_down_nodes.reserve(graph.number_of_nodes()*2);
+    // divide nodes into UP-nodes and DOWN-nodes
+    for (long n = 0; n < graph.number_of_nodes(); ++n) {
+        up_and_down_nodes.emplace_back(n, true, in_degree(graph, n));
+        up_and_down_nodes.emplace_back(n, false, out_degree(graph, n));
+    }
+    // sort up and down nodes by their degree in ascending order
+    std::sort(up_and_down_nodes.begin(), up_and_down_nodes.end(), [](auto const& a, auto const& b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+
+    std::vector<bool> handled_edges(graph.slab_.size(), false);
+
+    for(auto const& [n, is_up, degree] : up_and_down_nodes) {
+        if(is_up) {
+            for (auto p = graph.middle_[n]; p < graph.begin_[n+1]; ++p) { // loop in descending order through incoming_edges
+                auto const position = graph.twin_[p];
+                if (!handled_edges[position]) {
+                    handled_edges[position] = true;
+                    queue.emplace_back(position);
+                }
+            }
+        } else {
+            for (auto position = graph.begin_[n]; position < graph.middle_[n]; ++position) { // loop in ascending order through outgoing_edges
+                if (!handled_edges[position]) {
+                    handled_edges[position] = true;
+                    queue.emplace_back(position);
+                }
+            }
+        }
+    }
+
+    return queue;
+}
+
+// the queue contains each edge as (u, v). instead of remembering the handled edges, an edge is added while handling
+// whichever of UP(v) and DOWN(u) comes first in the sorted order, which needs no extra memory per edge
+std::vector<std::tuple<node_index, node_index>> sort_edge_tro_plus(compressed_graph const& graph) {
+    std::vector<std::tuple<node_index, node_index>> queue;
+    queue.reserve(graph.number_of_edges_);
+
+    std::vector<std::tuple<node_index, bool, long>> up_and_down_nodes; // (node, is_up, degree)
+    up_and_down_nodes.reserve(graph.number_of_nodes()*2);
+    // divide nodes into UP-nodes and DOWN-nodes
+    for (long n = 0; n < graph.number_of_nodes(); ++n) {
+        up_and_down_nodes.emplace_back(n, true, in_degree(graph, n));
+        up_and_down_nodes.emplace_back(n, false, out_degree(graph, n));
+    }
+    // sort up and down nodes by their degree in ascending order
+    std::sort(up_and_down_nodes.begin(), up_and_down_nodes.end(), [](auto const& a, auto const& b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+
+    std::vector<long> rank_up(graph.number_of_nodes());
+    std::vector<long> rank_down(graph.number_of_nodes());
+    for (long i = 0; i < static_cast<long>(up_and_down_nodes.size()); ++i) {
+        auto const& [n, is_up, degree] = up_and_down_nodes[i];
+        (is_up ? rank_up : rank_down)[n] = i;
+    }
+
+    for(auto const& [n, is_up, degree] : up_and_down_nodes) {
+        if(is_up) {
+            for (auto const incoming_node : graph.incoming_edges(n)) { // loop in descending order through incoming_edges
+                if (rank_down[incoming_node] > rank_up[n]) {
+                    queue.emplace_back(incoming_node, n);
+                }
+            }
+        } else {
+            for (auto const outgoing_node : graph.outgoing_edges(n)) { // loop in ascending order through outgoing_edges
+                if (rank_up[outgoing_node] > rank_down[n]) {
+                    queue.emplace_back(n, outgoing_node);
+                }
+            }
+        }
+    }
+
+    return queue;
+}
+
 template <size_t hash_range>
-bool is_redundant_tro_plus(labeled_graph<hash_range> const& labeled_graph, Edge const& edge, std::vector<long> const& to) {
+bool is_redundant_tro_plus(labeled_graph<hash_range> const& labeled_graph, Edge const& edge, std::vector<node_index> const& to) {
     auto const [u, v] = edge;
     auto const u_index = to[u->id_];
     auto const v_index = to[v->id_];
@@ -80,16 +213,111 @@ bool is_redundant_tro_plus(labeled_graph<hash_range> const& labeled_graph, Edge
 }
 
 // Algorithm 3 TR-O-Plus
+void tr_o_plus(graph& graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
+    auto const [to, to_reverse] = get_topological_order(graph);
+
+    with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        auto const labeled_graph = build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_);
+
+        auto queue = sort_edge_tro_plus(graph, to);
+
+        for(auto edge : queue) {
+            if(is_redundant_tro_plus(labeled_graph, edge, to)) {
+                graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+            }
+        }
+    });
+}
+
 void tr_o_plus(graph& graph) {
-    auto const hash_range = 1024;
+    tr_o_plus(graph, label_parameters{});
+}
+
+// Algorithm 3 TR-O-Plus
+csr_graph tr_o_plus(csr_graph graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
     auto const [to, to_reverse] = get_topological_order(graph);
-    auto const labeled_graph = build_labeled_graph<hash_range>(graph, [](node const* n) { return hash_in_range(n->id_, hash_range); }, hash_range*10);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
 
-    auto queue = sort_edge_tro_plus(graph, to);
+    return with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        if (parameters.memory_budget_ != 0) {
+            return tr_o_plus(graph, build_budgeted_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.memory_budget_), to, parameters.search_direction_, parameters.redundancy_check_);
+        }
+        return tr_o_plus(graph, build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_), to, parameters.search_direction_, parameters.redundancy_check_);
+    });
+}
 
-    for(auto edge : queue) {
-        if(is_redundant_tro_plus(labeled_graph, edge, to)) {
-            graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+csr_graph tr_o_plus(csr_graph graph) {
+    return tr_o_plus(std::move(graph), label_parameters{});
+}
+
+csr_graph tr_o_plus(csr_graph graph, std::size_t const label_memory_budget) {
+    auto parameters = label_parameters{};
+    parameters.memory_budget_ = label_memory_budget;
+    return tr_o_plus(std::move(graph), parameters);
+}
+
+// Algorithm 3 TR-O-Plus
+void tr_o_plus(slab_graph& graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
+    auto const [to, to_reverse] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+
+    with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        auto const labeled_graph = build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_);
+
+        auto queue = sort_edge_tro_plus(graph);
+
+        // the edges are removed while the queue is handled, so the outgoing edges of a node are not checked at once
+        auto const shared = parameters.redundancy_check_ == redundancy_check::per_edge;
+        auto& context = thread_query_context();
+        for(auto const position : queue) {
+            auto const u = graph.slab_[graph.twin_[position]];
+            auto const v = graph.slab_[position];
+            if(shared ? is_redundant_shared(labeled_graph, u, v, to, context) : is_redundant_tro_plus(labeled_graph, u, v, to, parameters.search_direction_)) {
+                graph.remove_edge_at(position);
+            }
         }
-    }
-}
\ No newline at end of file
+    });
+
+    graph.compact();
+}
+
+void tr_o_plus(slab_graph& graph) {
+    tr_o_plus(graph, label_parameters{});
+}
+
+// Algorithm 3 TR-O-Plus
+compressed_graph tr_o_plus(compressed_graph graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
+    auto const [to, to_reverse] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+
+    return with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        if (parameters.memory_budget_ != 0) {
+            return tr_o_plus(graph, build_budgeted_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.memory_budget_), to, parameters.search_direction_, parameters.redundancy_check_);
+        }
+        return tr_o_plus(graph, build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_), to, parameters.search_direction_, parameters.redundancy_check_);
+    });
+}
+
+compressed_graph tr_o_plus(compressed_graph graph) {
+    return tr_o_plus(std::move(graph), label_parameters{});
+}
+
+compressed_graph tr_o_plus(compressed_graph graph, std::size_t const label_memory_budget) {
+    auto parameters = label_parameters{};
+    parameters.memory_budget_ = label_memory_budget;
+    return tr_o_plus(std::move(graph), parameters);
+}
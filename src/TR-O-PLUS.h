@@ -1,5 +1,173 @@
+#pragma once
 #include "graphs.h"
 #include "BFL.h"
+#include "budgetedLabels.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "dagUtil.h"
+#include "labelParameters.h"
+#include "memoryPolicy.h"
+#include "queryContext.h"
+#include "reachabilityOracle.h"
+#include "redundancyCheck.h"
+#include "slabGraph.h"
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 // Algorithm 3 TR-O-Plus
-void tr_o_plus(graph& graph);
\ No newline at end of file
+void tr_o_plus(graph& graph);
+
+// the labels are built with the given parameters instead of hash_range 1024, a memory budget is only used by the csr_graph
+// and compressed_graph versions
+void tr_o_plus(graph& graph, label_parameters const& parameters);
+
+// the edges of graph are sorted in topological order, so pass the graph as rvalue if it is not needed anymore
+csr_graph tr_o_plus(csr_graph graph);
+
+// the labels are built with build_budgeted_labeled_graph, so they use at most label_memory_budget bytes
+csr_graph tr_o_plus(csr_graph graph, std::size_t label_memory_budget);
+
+csr_graph tr_o_plus(csr_graph graph, label_parameters const& parameters);
+
+// removes the redundant edges in place by marking them as tombstones, the slab is compacted once at the end
+void tr_o_plus(slab_graph& graph);
+
+void tr_o_plus(slab_graph& graph, label_parameters const& parameters);
+
+// the input and the reduced graph are kept compressed, the neighbors are decoded on the fly during the queries
+compressed_graph tr_o_plus(compressed_graph graph);
+
+// the same with labels that use at most label_memory_budget bytes
+compressed_graph tr_o_plus(compressed_graph graph, std::size_t label_memory_budget);
+
+compressed_graph tr_o_plus(compressed_graph graph, label_parameters const& parameters);
+
+// the queue of TR-O-Plus, each edge as its source and its position in graph.targets_out_
+std::vector<std::tuple<node_index, long long>> sort_edge_tro_plus(csr_graph const& graph, std::vector<node_index> const& to);
+
+// the queue of TR-O-Plus, each edge as (u, v)
+std::vector<std::tuple<node_index, node_index>> sort_edge_tro_plus(compressed_graph const& graph);
+
+// id based version for the csr_graph, slab_graph and compressed_graph representations, oracles with labels filter the witnesses first
+template <reachability_oracle Oracle>
+bool is_redundant_tro_plus(Oracle const& oracle, node_index const u, node_index const v, std::vector<node_index> const& to, search_direction const direction) {
+    if constexpr (labeled_reachability_oracle<Oracle>) {
+        return is_redundant_filtered(oracle, u, v, to, direction);
+    }
+    auto const& graph = oracle.graph_;
+    auto const u_index = to[u];
+    auto const v_index = to[v];
+    if(out_degree(graph, u) > in_degree(graph, v)) {
+        for (auto const w : predecessors(graph, v)) { // loop in descending order through incoming_edges
+            if (to[w] <= u_index) break; // add index check
+            if (query_oracle(oracle, u, w, direction)) {
+                return true;
+            }
+        }
+    } else {
+        for (auto const w : successors(graph, u)) { // loop in ascending order through outgoing_edges
+            if (to[w] >= v_index) break; // add index check
+            if (query_oracle(oracle, w, v, direction)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Algorithm 3 TR-O-Plus with the given reachability oracle of graph, graph needs to have its edges in topological order.
+// the shared redundancy checks need an oracle with labels, the other oracles are queried per witness
+template <reachability_oracle Oracle>
+csr_graph tr_o_plus(csr_graph const& graph, Oracle const& oracle, std::vector<node_index> const& to, search_direction const direction = search_direction::forward,
+                    redundancy_check const check = redundancy_check::per_witness) {
+    // the graph is never changed, so removed edges are only marked by their position in graph.targets_out_
+    std::vector<bool> removed(graph.number_of_edges(), false);
+
+    if constexpr (labeled_reachability_oracle<Oracle>) {
+        auto& context = thread_query_context();
+        if (check == redundancy_check::per_source) {
+            for (long u = 0; u < graph.number_of_nodes(); ++u) {
+                find_redundant_out_edges(oracle, u, context, [&removed, &graph, u](std::size_t const i, node_index) {
+                    removed[graph.offsets_out_[u] + i] = true;
+                });
+            }
+            return remove_edges(graph, removed);
+        }
+        if (check == redundancy_check::per_edge) {
+            for(auto const& [u, position] : sort_edge_tro_plus(graph, to)) {
+                if(is_redundant_shared(oracle, u, graph.targets_out_[position], to, context)) {
+                    removed[position] = true;
+                }
+            }
+            return remove_edges(graph, removed);
+        }
+    }
+
+    auto queue = sort_edge_tro_plus(graph, to);
+
+    for(auto const& [u, position] : queue) {
+        if(is_redundant_tro_plus(oracle, u, graph.targets_out_[position], to, direction)) {
+            removed[position] = true;
+        }
+    }
+
+    return remove_edges(graph, removed);
+}
+
+template <reachability_oracle Oracle>
+compressed_graph tr_o_plus(compressed_graph const& graph, Oracle const& oracle, std::vector<node_index> const& to, search_direction const direction = search_direction::forward,
+                           redundancy_check const check = redundancy_check::per_witness) {
+    std::vector<std::tuple<node_index, node_index>> removed;
+
+    if constexpr (labeled_reachability_oracle<Oracle>) {
+        auto& context = thread_query_context();
+        if (check == redundancy_check::per_source) {
+            for (long u = 0; u < graph.number_of_nodes(); ++u) {
+                find_redundant_out_edges(oracle, u, context, [&removed, u](std::size_t, node_index const v) {
+                    removed.emplace_back(u, v);
+                });
+            }
+        } else if (check == redundancy_check::per_edge) {
+            for(auto const& [u, v] : sort_edge_tro_plus(graph)) {
+                if(is_redundant_shared(oracle, u, v, to, context)) {
+                    removed.emplace_back(u, v);
+                }
+            }
+        }
+    }
+
+    if (check == redundancy_check::per_witness || !labeled_reachability_oracle<Oracle>) {
+        auto queue = sort_edge_tro_plus(graph);
+        for(auto const& [u, v] : queue) {
+            if(is_redundant_tro_plus(oracle, u, v, to, direction)) {
+                removed.emplace_back(u, v);
+            }
+        }
+    }
+
+    std::sort(removed.begin(), removed.end());
+    return remove_edges(graph, removed);
+}
+
+// the oracle is built by make_oracle(graph) after the edges of graph are sorted in topological order,
+// e.g. tr_o_plus(std::move(graph), [](csr_graph const& g) { return closure_oracle(g); })
+template <typename MakeOracle> requires reachability_oracle<std::invoke_result_t<MakeOracle const&, csr_graph const&>>
+csr_graph tr_o_plus(csr_graph graph, MakeOracle const& make_oracle) {
+    auto const [to, to_reverse] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+    return tr_o_plus(graph, make_oracle(graph), to);
+}
+
+template <typename MakeOracle> requires reachability_oracle<std::invoke_result_t<MakeOracle const&, compressed_graph const&>>
+compressed_graph tr_o_plus(compressed_graph graph, MakeOracle const& make_oracle) {
+    auto const [to, to_reverse] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+    return tr_o_plus(graph, make_oracle(graph), to);
+}
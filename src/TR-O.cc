@@ -4,9 +4,9 @@
 
 #include "BFL.h"
 #include "dagUtil.h"
-#include "MurmurHash3.h"
+#include "labelTuning.h"
 
-std::vector<Edge> sort_edge_tro(graph& graph, std::vector<long> const& to) {
+std::vector<Edge> sort_edge_tro(graph& graph, std::vector<node_index> const& to) {
     std::vector<Edge> queue;
 
     set_edges_in_topological_order(graph, to); // add sorting into topological order
@@ -21,7 +21,7 @@ std::vector<Edge> sort_edge_tro(graph& graph, std::vector<long> const& to) {
 }
 
 template <size_t hash_range>
-bool is_redundant_tro(labeled_graph<hash_range> const& labeled_graph, Edge const& edge, std::vector<long> const& to) {
+bool is_redundant_tro(labeled_graph<hash_range> const& labeled_graph, Edge const& edge, std::vector<node_index> const& to) {
     auto const [u, v] = edge;
     for (auto w : u->outgoing_edges_) {
         if (to[w->id_] >= to[v->id_]) break; // add index check
@@ -33,15 +33,41 @@ bool is_redundant_tro(labeled_graph<hash_range> const& labeled_graph, Edge const
 }
 
 // Algorithm 2 TR-O
-void tr_o(graph& graph) {
-    auto const hash_range = 1024;
+void tr_o(graph& graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
     auto const [to, to_revere] = get_topological_order(graph);
-    auto const labeled_graph = build_labeled_graph<hash_range>(graph, [](node const* n) { return hash_in_range(n->id_, hash_range); }, hash_range*10);
     auto queue = sort_edge_tro(graph, to);
 
-    for(auto edge : queue) {
-        if(is_redundant_tro(labeled_graph, edge, to)) {
-            graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+    with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        auto const labeled_graph = build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_);
+
+        for(auto edge : queue) {
+            if(is_redundant_tro(labeled_graph, edge, to)) {
+                graph.remove_edge(*std::get<0>(edge), *std::get<1>(edge));
+            }
         }
-    }
-}
\ No newline at end of file
+    });
+}
+
+void tr_o(graph& graph) {
+    tr_o(graph, label_parameters{});
+}
+
+// Algorithm 2 TR-O
+csr_graph tr_o(csr_graph graph, label_parameters const& requested) {
+    auto const parameters = resolve_label_parameters(graph, requested);
+    auto const [to, to_revere] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+
+    return with_hash_range(parameters.hash_range_, [&](auto const width) {
+        auto constexpr hash_range = decltype(width)::value;
+        return tr_o(graph, build_labeled_graph<hash_range>(graph, parameters.bucket_assignment_, parameters.d_, parameters.number_of_interval_labelings_), to);
+    });
+}
+
+csr_graph tr_o(csr_graph graph) {
+    return tr_o(std::move(graph), label_parameters{});
+}
@@ -1,5 +1,60 @@
+#pragma once
 #include "graphs.h"
+#include "csrGraph.h"
+#include "dagUtil.h"
+#include "labelParameters.h"
+#include "memoryPolicy.h"
+#include "reachabilityOracle.h"
+
+#include <type_traits>
 
 using namespace graphs;
 
-void tr_o(graph& graph);
\ No newline at end of file
+void tr_o(graph& graph);
+
+// the labels are built with the given parameters instead of hash_range 1024
+void tr_o(graph& graph, label_parameters const& parameters);
+
+// the edges of graph are sorted in topological order, so pass the graph as rvalue if it is not needed anymore
+csr_graph tr_o(csr_graph graph);
+
+csr_graph tr_o(csr_graph graph, label_parameters const& parameters);
+
+// returns whether one of the successors of u before v in topological order reaches v
+template <reachability_oracle Oracle>
+bool is_redundant_tro(Oracle const& oracle, node_index const u, node_index const v, std::vector<node_index> const& to) {
+    for (auto const w : successors(oracle.graph_, u)) {
+        if (to[w] >= to[v]) break; // add index check
+        if (query_reachability(oracle, w, v)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Algorithm 2 TR-O with the given reachability oracle of graph, graph needs to have its edges in topological order
+template <reachability_oracle Oracle>
+csr_graph tr_o(csr_graph const& graph, Oracle const& oracle, std::vector<node_index> const& to) {
+    // the graph is never changed, so removed edges are only marked by their position in graph.targets_out_
+    std::vector<bool> removed(graph.number_of_edges(), false);
+
+    for(long u = 0; u < graph.number_of_nodes(); ++u) {
+        for(auto i = graph.offsets_out_[u]; i < graph.offsets_out_[u+1]; ++i) {
+            if(is_redundant_tro(oracle, u, graph.targets_out_[i], to)) {
+                removed[i] = true;
+            }
+        }
+    }
+
+    return remove_edges(graph, removed);
+}
+
+// the oracle is built by make_oracle(graph) after the edges of graph are sorted in topological order
+template <typename MakeOracle> requires reachability_oracle<std::invoke_result_t<MakeOracle const&, csr_graph const&>>
+csr_graph tr_o(csr_graph graph, MakeOracle const& make_oracle) {
+    auto const [to, to_reverse] = get_topological_order(graph);
+    set_edges_in_topological_order(graph, to);
+    scoped_thread_pin const pin(0);
+    apply_memory_policy(graph, to);
+    return tr_o(graph, make_oracle(graph), to);
+}
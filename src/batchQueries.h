@@ -0,0 +1,150 @@
+#pragma once
+#include "graphs.h"
+#include "interleavedQueries.h"
+#include "memoryPolicy.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace graphs;
+
+// a query whether the first node reaches the second one
+using reachability_query = std::tuple<node_index, node_index>;
+
+// the answers of a batch of queries, bit i is the answer of query i
+struct reachability_bitmap {
+    std::vector<std::uint64_t> words_;
+    std::size_t size_;
+
+    explicit reachability_bitmap(std::size_t const size) : words_((size + 63) / 64, 0), size_(size) {}
+
+    bool operator[](std::size_t const i) const {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    // the number of reachable queries
+    std::size_t count() const {
+        std::size_t count = 0;
+        for (auto const word : words_) count += std::popcount(word);
+        return count;
+    }
+};
+
+// the queries are handed out to the threads in blocks of this size, a multiple of 64 so each word of the bitmap has one writer
+inline constexpr std::size_t query_block_size = 4096;
+
+// how many queries ahead the labels are prefetched in the label-only pass
+inline constexpr std::size_t query_prefetch_distance = 8;
+
+// runs work(worker) on number_of_workers threads, the calling thread is worker 0. the workers are pinned by the memory policy
+template <typename Work>
+void run_workers(std::size_t const number_of_workers, Work const& work) {
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_workers - 1);
+    for (std::size_t worker = 1; worker < number_of_workers; ++worker) {
+        threads.emplace_back([&work, worker] {
+            pin_current_thread(worker);
+            work(worker);
+        });
+    }
+    work(0);
+    for (auto& thread : threads) thread.join();
+}
+
+/**
+ * answers a batch of queries on number_of_threads threads (0 means one per core), LabeledGraph is a labeled_graph or a
+ * budgeted_labeled_graph. the first pass answers every query whose labels decide it with check_labels(u, v), prefetching
+ * the labels a few queries ahead, so the SIMD subset kernels run back to back without waiting for memory. only the
+ * remaining queries are searched in the second pass, each thread with its own query_context. with more than one lane the
+ * forward searches of each thread are interleaved by run_interleaved_queries
+ */
+template <typename LabeledGraph>
+reachability_bitmap query_reachability_batch(LabeledGraph const& graph, std::span<reachability_query const> const queries, std::size_t number_of_threads = 0,
+                                             search_direction const direction = search_direction::forward, std::size_t const number_of_lanes = 1) {
+    reachability_bitmap results(queries.size());
+    if (number_of_threads == 0) number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+    auto const number_of_blocks = (queries.size() + query_block_size - 1) / query_block_size;
+    auto const number_of_workers = std::max<std::size_t>(1, std::min(number_of_threads, number_of_blocks));
+
+    // label-only pass, the positions of the queries the labels do not decide are collected per worker
+    std::vector<std::vector<std::size_t>> unknown(number_of_workers);
+    std::atomic<std::size_t> next_block{0};
+    run_workers(number_of_workers, [&](std::size_t const worker) {
+        for (auto block = next_block++; block < number_of_blocks; block = next_block++) {
+            auto const first = block * query_block_size;
+            auto const last = std::min(first + query_block_size, queries.size());
+            for (auto i = first; i < last; ++i) {
+                if (i + query_prefetch_distance < last) {
+                    auto const [u, v] = queries[i + query_prefetch_distance];
+                    prefetch_labels(graph, u);
+                    prefetch_labels(graph, v);
+                }
+                auto const [u, v] = queries[i];
+                auto const answer = check_labels(graph, u, v);
+                if (answer == label_answer::reachable) results.words_[i / 64] |= std::uint64_t{1} << (i % 64);
+                else if (answer == label_answer::unknown) unknown[worker].push_back(i);
+            }
+        }
+    });
+
+    std::vector<std::size_t> searched;
+    for (auto const& positions : unknown) searched.insert(searched.end(), positions.begin(), positions.end());
+    if (searched.empty()) return results;
+    std::sort(searched.begin(), searched.end());
+
+    // search pass, the queries are handed out in chunks of 64 and the answers are written to one byte each
+    std::vector<std::uint8_t> answers(searched.size());
+    auto const number_of_chunks = (searched.size() + 63) / 64;
+    std::atomic<std::size_t> next_chunk{0};
+    auto const interleaved = number_of_lanes > 1 && direction == search_direction::forward;
+    run_workers(std::min(number_of_threads, number_of_chunks), [&](std::size_t) {
+        query_context context;
+        std::vector<query_lane> lanes(interleaved ? number_of_lanes : 0);
+        for (auto chunk = next_chunk++; chunk < number_of_chunks; chunk = next_chunk++) {
+            auto const first = chunk * 64;
+            auto const last = std::min(first + 64, searched.size());
+            if (interleaved) {
+                run_interleaved_queries(graph, queries, std::span(searched).subspan(first, last - first), lanes,
+                    [&answers, &searched, first, last](std::size_t const i, bool const reachable) {
+                        answers[std::lower_bound(searched.begin() + first, searched.begin() + last, i) - searched.begin()] = reachable;
+                    });
+                continue;
+            }
+            for (auto j = first; j < last; ++j) {
+                auto const [u, v] = queries[searched[j]];
+                answers[j] = query_reachability(graph, u, v, context, direction);
+            }
+        }
+    });
+
+    for (std::size_t j = 0; j < searched.size(); ++j) {
+        if (answers[j]) results.words_[searched[j] / 64] |= std::uint64_t{1} << (searched[j] % 64);
+    }
+    return results;
+}
+
+// answers all queries on the calling thread with number_of_lanes queries in flight, see run_interleaved_queries
+template <typename LabeledGraph>
+reachability_bitmap query_reachability_interleaved(LabeledGraph const& graph, std::span<reachability_query const> const queries,
+                                                   std::size_t const number_of_lanes = default_number_of_lanes) {
+    reachability_bitmap results(queries.size());
+    std::vector<std::size_t> positions(queries.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) positions[i] = i;
+    std::vector<query_lane> lanes(std::max<std::size_t>(1, number_of_lanes));
+    run_interleaved_queries(graph, queries, positions, lanes, [&results](std::size_t const i, bool const reachable) {
+        if (reachable) results.words_[i / 64] |= std::uint64_t{1} << (i % 64);
+    });
+    return results;
+}
@@ -0,0 +1,252 @@
+#pragma once
+#include "graphs.h"
+#include "labelArena.h"
+#include "BFL.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * describes where the label of a node is stored in a budgeted_labeled_graph
+ * width_ == 0: the label is sparse, positions_[offset_] ... positions_[offset_+size_-1] are its sorted bits
+ * width_ > 0: the label is dense with width_ bits in words_[offset_] ..., a bit b of the original label is stored as b % width_
+ */
+struct label_descriptor {
+    std::uint64_t offset_;
+    std::uint32_t size_;
+    std::uint32_t width_;
+};
+
+/**
+ * BFL labels that fit into a given memory budget
+ * labels with few bits (usually the ones near the sources and sinks) are stored as sorted lists of their bits, the others
+ * as dense words. if the budget left for a label does not allow a dense label of the full hash_range, the label is folded
+ * to a smaller power of two width. a node is folded at least as far as its successors (or predecessors for label_in),
+ * so the subset tests of the queries keep their meaning, they only prune less if the labels are folded
+ */
+template <size_t hash_range, typename Graph = graph>
+struct budgeted_labeled_graph {
+    static_assert(hash_range <= 65536, "the bits of sparse labels are stored as 16 bit positions");
+    static constexpr std::size_t words_per_label = label_arena<hash_range>::words_per_label;
+    static constexpr std::uint32_t minimal_width = 64;
+
+    Graph const& graph_;
+    std::vector<interval> intervals_;
+    std::vector<label_descriptor> label_out_;
+    std::vector<label_descriptor> label_in_;
+    std::vector<std::uint16_t> positions_;
+    std::vector<std::uint64_t> words_;
+
+    explicit budgeted_labeled_graph(Graph const& graph)
+        : graph_(graph), intervals_(number_of_nodes(graph), interval{0, 0}), label_out_(number_of_nodes(graph)), label_in_(number_of_nodes(graph)) {}
+
+    std::size_t size_in_bytes() const {
+        return intervals_.size() * sizeof(interval) + (label_out_.size() + label_in_.size()) * sizeof(label_descriptor)
+            + positions_.size() * sizeof(std::uint16_t) + words_.size() * sizeof(std::uint64_t);
+    }
+
+    // the smallest budget build_budgeted_labeled_graph accepts
+    static std::size_t minimal_size_in_bytes(long const number_of_nodes) {
+        return number_of_nodes * (sizeof(interval) + 2 * sizeof(label_descriptor) + 2 * ((std::min<std::size_t>(minimal_width, hash_range) + 63) / 64 * sizeof(std::uint64_t)));
+    }
+};
+
+// a label folded to width bits, in words_per_label words
+template <size_t hash_range>
+struct folded_label {
+    std::uint64_t words_[label_arena<hash_range>::words_per_label];
+    std::uint32_t width_;
+};
+
+template <size_t hash_range>
+std::uint32_t label_width(label_descriptor const& label) {
+    return label.width_ == 0 ? static_cast<std::uint32_t>(hash_range) : label.width_;
+}
+
+// writes the label folded to width bits into folded, width needs to divide the width of the label (or be smaller than hash_range)
+template <size_t hash_range, typename Graph>
+void fold_label(budgeted_labeled_graph<hash_range, Graph> const& graph, label_descriptor const& label, std::uint32_t const width, folded_label<hash_range>& folded) {
+    folded.width_ = width;
+    std::fill(std::begin(folded.words_), std::end(folded.words_), 0);
+    if (label.width_ == 0) {
+        for (std::uint32_t i = 0; i < label.size_; ++i) {
+            set_label_bit<hash_range>(folded.words_, graph.positions_[label.offset_ + i] % width);
+        }
+    } else if (label.width_ % width == 0 && width % 64 == 0) {
+        // both widths are multiples of 64, so whole words can be folded
+        auto const words = width / 64;
+        for (std::uint32_t i = 0; i < label.width_ / 64; ++i) {
+            folded.words_[i % words] |= graph.words_[label.offset_ + i];
+        }
+    } else {
+        for (std::uint32_t bit = 0; bit < label.width_; ++bit) {
+            if ((graph.words_[label.offset_ + bit / 64] >> (bit % 64)) & 1) set_label_bit<hash_range>(folded.words_, bit % width);
+        }
+    }
+}
+
+// returns whether the label subset is a subset of the label superset after folding both to their common width
+template <size_t hash_range, typename Graph>
+bool label_is_subset(budgeted_labeled_graph<hash_range, Graph> const& graph, label_descriptor const& subset, label_descriptor const& superset) {
+    if (subset.width_ == 0 && superset.width_ == 0) {
+        auto const* first = graph.positions_.data() + superset.offset_;
+        auto const* last = first + superset.size_;
+        for (std::uint32_t i = 0; i < subset.size_; ++i) {
+            first = std::lower_bound(first, last, graph.positions_[subset.offset_ + i]);
+            if (first == last || *first != graph.positions_[subset.offset_ + i]) return false;
+        }
+        return true;
+    }
+    auto const width = std::min(label_width<hash_range>(subset), label_width<hash_range>(superset));
+    if (subset.width_ == width && superset.width_ == width) {
+        for (std::uint32_t i = 0; i < (width + 63) / 64; ++i) {
+            if (graph.words_[subset.offset_ + i] & ~graph.words_[superset.offset_ + i]) return false;
+        }
+        return true;
+    }
+    folded_label<hash_range> folded_subset;
+    folded_label<hash_range> folded_superset;
+    fold_label(graph, subset, width, folded_subset);
+    fold_label(graph, superset, width, folded_superset);
+    return label_is_subset<hash_range>(folded_subset.words_, folded_superset.words_);
+}
+
+// stores the label in scratch (of the given width) with the smallest representation that fits into allowance bytes
+template <size_t hash_range, typename Graph>
+label_descriptor store_label(budgeted_labeled_graph<hash_range, Graph>& graph, folded_label<hash_range>& scratch, std::size_t const allowance) {
+    std::uint32_t size = 0;
+    for (auto const word : scratch.words_) size += std::popcount(word);
+
+    if (scratch.width_ == hash_range && size * sizeof(std::uint16_t) <= std::min(allowance, label_arena<hash_range>::words_per_label * sizeof(std::uint64_t))) {
+        label_descriptor const label{graph.positions_.size(), size, 0};
+        for (std::uint32_t bit = 0; bit < hash_range; ++bit) {
+            if ((scratch.words_[bit / 64] >> (bit % 64)) & 1) graph.positions_.push_back(bit);
+        }
+        return label;
+    }
+
+    // fold the label until it fits, but not below the minimal width
+    auto width = scratch.width_;
+    while ((width + 63) / 64 * sizeof(std::uint64_t) > allowance && width > graph.minimal_width) {
+        width = std::bit_floor(width - 1);
+    }
+    if (width != scratch.width_) {
+        label_descriptor const unfolded{graph.words_.size(), 0, scratch.width_};
+        graph.words_.insert(graph.words_.end(), scratch.words_, scratch.words_ + (scratch.width_ + 63) / 64);
+        fold_label(graph, unfolded, width, scratch);
+        graph.words_.resize(unfolded.offset_);
+    }
+
+    label_descriptor const label{graph.words_.size(), 0, width};
+    graph.words_.insert(graph.words_.end(), scratch.words_, scratch.words_ + (width + 63) / 64);
+    return label;
+}
+
+/**
+ * builds the labels of one direction in the given order, in which the neighbors of each node need to come before the node
+ * every label gets an equal share of the remaining budget, so the budget saved by sparse labels is passed on to the later labels
+ */
+template <size_t hash_range, typename Graph, typename Order, typename Neighbors>
+void compute_budgeted_labels(budgeted_labeled_graph<hash_range, Graph>& graph, std::vector<label_descriptor>& labels, Order const& order,
+                             Neighbors const& neighbors, bucket_array const& buckets, std::size_t budget) {
+    auto remaining_labels = static_cast<std::size_t>(labels.size());
+    auto const used_before = graph.positions_.size() * sizeof(std::uint16_t) + graph.words_.size() * sizeof(std::uint64_t);
+    folded_label<hash_range> scratch;
+    folded_label<hash_range> folded;
+
+    for (auto const n : order) {
+        auto const used = graph.positions_.size() * sizeof(std::uint16_t) + graph.words_.size() * sizeof(std::uint64_t) - used_before;
+        auto const allowance = used < budget ? (budget - used) / remaining_labels : 0;
+        --remaining_labels;
+
+        // the label has to be folded at least as far as the labels of all neighbors
+        scratch.width_ = hash_range;
+        for (auto const m : neighbors(n)) {
+            scratch.width_ = std::min(scratch.width_, label_width<hash_range>(labels[m]));
+        }
+        std::fill(std::begin(scratch.words_), std::end(scratch.words_), 0);
+        set_label_bit<hash_range>(scratch.words_, buckets[n] % scratch.width_);
+        for (auto const m : neighbors(n)) {
+            fold_label(graph, labels[m], scratch.width_, folded);
+            unite_labels<hash_range>(scratch.words_, folded.words_);
+        }
+
+        labels[n] = store_label(graph, scratch, allowance);
+    }
+}
+
+// memory_budget is the number of bytes the intervals and labels may use at most, the policy assigns the buckets as for build_labeled_graph
+template <size_t hash_range, typename Graph, bucket_source Buckets>
+budgeted_labeled_graph<hash_range, Graph> build_budgeted_labeled_graph(Graph const& graph, Buckets const& policy, long const d, std::size_t const memory_budget) {
+    auto const num_of_nodes = number_of_nodes(graph);
+    if (memory_budget < budgeted_labeled_graph<hash_range, Graph>::minimal_size_in_bytes(num_of_nodes)) {
+        throw std::invalid_argument("the memory budget is too small for the labels of the graph");
+    }
+
+    budgeted_labeled_graph<hash_range, Graph> labeled(graph);
+
+    auto const post_order = depth_first_search(graph, labeled.intervals_.data());
+    auto const buckets = assign_buckets<hash_range>(post_order, d, policy);
+
+    auto const fixed_size = labeled.size_in_bytes();
+    auto const labels_budget = (memory_budget - fixed_size) / 2;
+
+    // in post order the successors of a node come before the node, in reverse post order its predecessors
+    compute_budgeted_labels(labeled, labeled.label_out_, post_order, [&graph](node_index const n) { return successors(graph, n); }, buckets, labels_budget);
+    compute_budgeted_labels(labeled, labeled.label_in_, post_order | std::views::reverse, [&graph](node_index const n) { return predecessors(graph, n); }, buckets, labels_budget);
+
+    labeled.positions_.shrink_to_fit();
+    labeled.words_.shrink_to_fit();
+    return labeled;
+}
+
+template <size_t hash_range, typename Graph>
+label_answer check_labels(budgeted_labeled_graph<hash_range, Graph> const& graph, node_index const n, node_index const v) {
+    if(graph.intervals_[n].discovery_ <= graph.intervals_[v].discovery_ && graph.intervals_[v].finish_ <= graph.intervals_[n].finish_) {
+        return label_answer::reachable;
+    }
+    // if L_out(v) !subset_of L_out(n) or L_in(n) !subset_of L_in(v)
+    if(!label_is_subset(graph, graph.label_out_[v], graph.label_out_[n])
+        || !label_is_subset(graph, graph.label_in_[n], graph.label_in_[v])) {
+        return label_answer::unreachable;
+    }
+    return label_answer::unknown;
+}
+
+template <size_t hash_range, typename Graph>
+interval const& dfs_interval(budgeted_labeled_graph<hash_range, Graph> const& graph, node_index const n) {
+    return graph.intervals_[n];
+}
+
+// prefetches the interval and the label descriptors of node n, the labels themselves are only known after the descriptors are read
+template <size_t hash_range, typename Graph>
+void prefetch_labels(budgeted_labeled_graph<hash_range, Graph> const& graph, node_index const n) {
+    __builtin_prefetch(graph.intervals_.data() + n);
+    __builtin_prefetch(graph.label_out_.data() + n);
+    __builtin_prefetch(graph.label_in_.data() + n);
+}
+
+template <size_t hash_range, typename Graph>
+bool query_reachability(budgeted_labeled_graph<hash_range, Graph> const& graph, node_index const u, node_index const v, query_context& context,
+                        search_direction const direction = search_direction::forward) {
+    auto const check = [&graph, v](node_index const n) { return check_labels(graph, n, v); };
+    auto const prefetch = [&graph](node_index const n) { prefetch_labels(graph, n); };
+    if(resolve_search_direction(graph.graph_, u, v, direction) == search_direction::bidirectional) {
+        context.begin_bidirectional_query(number_of_nodes(graph.graph_));
+        return search_reachability_bidirectional(graph.graph_, u, v, context, check,
+            [&graph, u](node_index const n) { return check_labels(graph, u, n); }, prefetch);
+    }
+    context.begin_query(number_of_nodes(graph.graph_));
+    return search_reachability(graph.graph_, u, context, check, prefetch);
+}
+
+template <size_t hash_range, typename Graph>
+bool query_reachability(budgeted_labeled_graph<hash_range, Graph> const& graph, node_index const u, node_index const v, search_direction const direction = search_direction::forward) {
+    return query_reachability<hash_range>(graph, u, v, thread_query_context(), direction);
+}
@@ -0,0 +1,101 @@
+#include "compressedGraph.h"
+
+#include <algorithm>
+
+namespace graphs {
+
+void append_varint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+void append_row(std::vector<std::uint8_t>& bytes, node_index const id, std::span<node_index const> const row) {
+    append_varint(bytes, row.size());
+    auto previous = static_cast<std::int64_t>(id);
+    for (auto const m : row) {
+        auto const gap = static_cast<std::int64_t>(m) - previous;
+        append_varint(bytes, (static_cast<std::uint64_t>(gap) << 1) ^ static_cast<std::uint64_t>(gap >> 63)); // zigzag encoding
+        previous = static_cast<std::int64_t>(m);
+    }
+}
+
+compressed_graph::compressed_graph(csr_graph const& g) : offsets_out_(g.number_of_nodes() + 1, 0), offsets_in_(g.number_of_nodes() + 1, 0), number_of_edges_(g.number_of_edges()) {
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        offsets_out_[i] = static_cast<long long>(bytes_out_.size());
+        offsets_in_[i] = static_cast<long long>(bytes_in_.size());
+        append_row(bytes_out_, i, g.outgoing_edges(i));
+        append_row(bytes_in_, i, g.incoming_edges(i));
+    }
+    offsets_out_.back() = static_cast<long long>(bytes_out_.size());
+    offsets_in_.back() = static_cast<long long>(bytes_in_.size());
+    bytes_out_.shrink_to_fit();
+    bytes_in_.shrink_to_fit();
+}
+
+compressed_graph remove_edges(compressed_graph const& g, std::vector<std::tuple<node_index, node_index>> const& removed) {
+    auto const num_of_nodes = g.number_of_nodes();
+    std::vector<std::uint8_t> bytes_out;
+    std::vector<long long> offsets_out(num_of_nodes + 1, 0);
+    std::vector<node_index> row;
+
+    // the removed edges of node u are removed[first] ... removed[last-1]
+    auto first = removed.begin();
+    for (long u = 0; u < num_of_nodes; ++u) {
+        auto last = first;
+        while (last != removed.end() && std::get<0>(*last) == u) ++last;
+
+        row.clear();
+        for (auto const v : g.outgoing_edges(u)) {
+            if (std::binary_search(first, last, std::make_tuple(static_cast<node_index>(u), v))) continue;
+            row.push_back(v);
+        }
+        offsets_out[u] = static_cast<long long>(bytes_out.size());
+        append_row(bytes_out, u, row);
+        first = last;
+    }
+    offsets_out.back() = static_cast<long long>(bytes_out.size());
+
+    // keep the order of the incoming edges and drop the removed ones
+    std::vector<std::uint8_t> bytes_in;
+    std::vector<long long> offsets_in(num_of_nodes + 1, 0);
+    for (long v = 0; v < num_of_nodes; ++v) {
+        row.clear();
+        for (auto const u : g.incoming_edges(v)) {
+            if (std::binary_search(removed.begin(), removed.end(), std::make_tuple(u, static_cast<node_index>(v)))) continue;
+            row.push_back(u);
+        }
+        offsets_in[v] = static_cast<long long>(bytes_in.size());
+        append_row(bytes_in, v, row);
+    }
+    offsets_in.back() = static_cast<long long>(bytes_in.size());
+
+    bytes_out.shrink_to_fit();
+    bytes_in.shrink_to_fit();
+    return {std::move(bytes_out), std::move(offsets_out), std::move(bytes_in), std::move(offsets_in), g.number_of_edges_ - static_cast<long long>(removed.size())};
+}
+
+csr_graph to_csr_graph(compressed_graph const& g) {
+    csr_graph csr;
+    csr.offsets_out_.resize(g.number_of_nodes() + 1, 0);
+    csr.offsets_in_.resize(g.number_of_nodes() + 1, 0);
+    csr.targets_out_.reserve(g.number_of_edges_);
+    csr.targets_in_.reserve(g.number_of_edges_);
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        for (auto const m : g.outgoing_edges(i)) {
+            csr.targets_out_.push_back(m);
+        }
+        for (auto const m : g.incoming_edges(i)) {
+            csr.targets_in_.push_back(m);
+        }
+        csr.offsets_out_[i+1] = static_cast<long long>(csr.targets_out_.size());
+        csr.offsets_in_[i+1] = static_cast<long long>(csr.targets_in_.size());
+    }
+
+    return csr;
+}
+
+} // namespace graphs
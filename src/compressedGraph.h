@@ -0,0 +1,157 @@
+#pragma once
+#include "graphs.h"
+#include "csrGraph.h"
+
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace graphs {
+
+// iterates over a row of a compressed_graph and decodes the neighbors on the fly
+struct varint_iterator {
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = node_index;
+    using difference_type = std::ptrdiff_t;
+
+    varint_iterator() = default;
+    varint_iterator(std::uint8_t const* position, long remaining, node_index previous) : position_(position), remaining_(remaining), current_(previous) {
+        if (remaining_ > 0) decode_next();
+    }
+
+    node_index operator*() const {
+        return current_;
+    }
+
+    varint_iterator& operator++() {
+        if (--remaining_ > 0) decode_next();
+        return *this;
+    }
+
+    varint_iterator operator++(int) {
+        auto const copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    bool operator==(varint_iterator const& other) const {
+        return position_ == other.position_ && remaining_ == other.remaining_;
+    }
+
+    bool operator==(std::default_sentinel_t) const {
+        return remaining_ <= 0;
+    }
+
+    std::uint8_t const* position_ = nullptr;
+    long remaining_ = 0;
+    node_index current_ = 0;
+
+    void decode_next() {
+        std::uint64_t value = 0;
+        int shift = 0;
+        while (*position_ & 0x80) {
+            value |= static_cast<std::uint64_t>(*position_++ & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= static_cast<std::uint64_t>(*position_++) << shift;
+        // undo the zigzag encoding of the gap
+        auto const gap = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        current_ = static_cast<node_index>(static_cast<std::int64_t>(current_) + gap);
+    }
+};
+
+struct varint_range {
+    std::uint8_t const* position_;
+    long size_;
+    node_index first_reference_;
+
+    varint_iterator begin() const {
+        return {position_, size_, first_reference_};
+    }
+
+    std::default_sentinel_t end() const {
+        return {};
+    }
+};
+
+/**
+ * immutable graph that stores each row of neighbors as varint encoded gaps
+ * a row starts with the number of neighbors, followed by the gap of each neighbor to its predecessor in the row
+ * (the first gap is taken to the node itself). the gaps are zigzag encoded, so the rows can be kept in any order,
+ * e.g. in topological order for the TR engines. rows that are sorted by id only use small positive gaps
+ */
+struct compressed_graph {
+    std::vector<std::uint8_t> bytes_out_;
+    std::vector<long long> offsets_out_;
+    std::vector<std::uint8_t> bytes_in_;
+    std::vector<long long> offsets_in_;
+    long long number_of_edges_;
+
+    explicit compressed_graph(csr_graph const& g);
+    compressed_graph(std::vector<std::uint8_t> bytes_out, std::vector<long long> offsets_out, std::vector<std::uint8_t> bytes_in, std::vector<long long> offsets_in, long long number_of_edges)
+        : bytes_out_(std::move(bytes_out)), offsets_out_(std::move(offsets_out)), bytes_in_(std::move(bytes_in)), offsets_in_(std::move(offsets_in)), number_of_edges_(number_of_edges) {}
+
+    long number_of_nodes() const {
+        return static_cast<long>(offsets_out_.size()) - 1;
+    }
+
+    varint_range outgoing_edges(node_index const id) const {
+        return row(bytes_out_, offsets_out_, id);
+    }
+
+    varint_range incoming_edges(node_index const id) const {
+        return row(bytes_in_, offsets_in_, id);
+    }
+
+    std::size_t size_in_bytes() const {
+        return bytes_out_.size() + bytes_in_.size() + (offsets_out_.size() + offsets_in_.size()) * sizeof(long long);
+    }
+
+    static varint_range row(std::vector<std::uint8_t> const& bytes, std::vector<long long> const& offsets, node_index const id) {
+        auto const* position = bytes.data() + offsets[id];
+        // the number of neighbors is stored as an unsigned varint
+        long size = 0;
+        int shift = 0;
+        while (*position & 0x80) {
+            size |= static_cast<long>(*position++ & 0x7f) << shift;
+            shift += 7;
+        }
+        size |= static_cast<long>(*position++) << shift;
+        return {position, size, id};
+    }
+};
+
+inline long number_of_nodes(compressed_graph const& g) {
+    return g.number_of_nodes();
+}
+
+inline varint_range successors(compressed_graph const& g, node_index const id) {
+    return g.outgoing_edges(id);
+}
+
+inline varint_range predecessors(compressed_graph const& g, node_index const id) {
+    return g.incoming_edges(id);
+}
+
+inline long out_degree(compressed_graph const& g, node_index const id) {
+    return g.outgoing_edges(id).size_;
+}
+
+inline long in_degree(compressed_graph const& g, node_index const id) {
+    return g.incoming_edges(id).size_;
+}
+
+inline void prefetch_successors(compressed_graph const& g, node_index const id) {
+    __builtin_prefetch(g.bytes_out_.data() + g.offsets_out_[id]);
+}
+
+// appends the encoded row of node id to bytes, the first gap is taken to id itself
+void append_row(std::vector<std::uint8_t>& bytes, node_index id, std::span<node_index const> row);
+
+// returns a new compressed_graph without the given edges, removed needs to be sorted
+compressed_graph remove_edges(compressed_graph const& g, std::vector<std::tuple<node_index, node_index>> const& removed);
+
+csr_graph to_csr_graph(compressed_graph const& g);
+
+} // namespace graphs
@@ -0,0 +1,79 @@
+#include "csrGraph.h"
+
+namespace graphs {
+
+csr_graph::csr_graph(graph const& g) : offsets_out_(g.nodes_.size() + 1, 0), offsets_in_(g.nodes_.size() + 1, 0) {
+    targets_out_.reserve(g.number_of_edges_);
+    targets_in_.reserve(g.number_of_edges_);
+
+    for (std::size_t i = 0; i < g.nodes_.size(); ++i) {
+        for (auto const m : g.nodes_[i].outgoing_edges_) {
+            targets_out_.push_back(m->id_);
+        }
+        for (auto const m : g.nodes_[i].incoming_edges_) {
+            targets_in_.push_back(m->id_);
+        }
+        offsets_out_[i+1] = static_cast<long long>(targets_out_.size());
+        offsets_in_[i+1] = static_cast<long long>(targets_in_.size());
+    }
+}
+
+csr_graph::csr_graph(std::vector<long long> offsets_out, std::vector<node_index> targets_out)
+    : offsets_out_(std::move(offsets_out)), targets_out_(std::move(targets_out)), offsets_in_(offsets_out_.size(), 0), targets_in_(targets_out_.size()) {
+    // counting sort of the edges by their target
+    for (auto const target : targets_out_) {
+        ++offsets_in_[target + 1];
+    }
+    for (long i = 0; i < number_of_nodes(); ++i) {
+        offsets_in_[i+1] += offsets_in_[i];
+    }
+
+    std::vector<long long> next(offsets_in_.begin(), offsets_in_.end() - 1);
+    for (long i = 0; i < number_of_nodes(); ++i) {
+        for (auto const target : outgoing_edges(i)) {
+            targets_in_[next[target]++] = i;
+        }
+    }
+}
+
+csr_graph remove_edges(csr_graph const& g, std::vector<bool> const& removed) {
+    std::vector<long long> offsets_out(g.offsets_out_.size(), 0);
+    std::vector<node_index> targets_out;
+    targets_out.reserve(g.number_of_edges());
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        for (auto j = g.offsets_out_[i]; j < g.offsets_out_[i+1]; ++j) {
+            if (!removed[j]) targets_out.push_back(g.targets_out_[j]);
+        }
+        offsets_out[i+1] = static_cast<long long>(targets_out.size());
+    }
+    targets_out.shrink_to_fit();
+
+    return {std::move(offsets_out), std::move(targets_out)};
+}
+
+graph to_graph(csr_graph const& g) {
+    graph new_graph;
+    new_graph.nodes_.reserve(g.number_of_nodes());
+    new_graph.number_of_edges_ = g.number_of_edges();
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        new_graph.nodes_.emplace_back(i);
+    }
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        auto& n = new_graph.nodes_[i];
+        n.outgoing_edges_.reserve(out_degree(g, i));
+        n.incoming_edges_.reserve(in_degree(g, i));
+        for (auto const m : g.outgoing_edges(i)) {
+            n.outgoing_edges_.push_back(&new_graph.nodes_[m]);
+        }
+        for (auto const m : g.incoming_edges(i)) {
+            n.incoming_edges_.push_back(&new_graph.nodes_[m]);
+        }
+    }
+
+    return new_graph;
+}
+
+} // namespace graphs
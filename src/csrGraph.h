@@ -0,0 +1,74 @@
+#pragma once
+#include "graphs.h"
+
+#include <span>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * immutable compressed sparse row representation of a graph
+ * the outgoing edges of node i are stored in targets_out_[offsets_out_[i]] ... targets_out_[offsets_out_[i+1]-1]
+ * and the incoming edges in targets_in_[offsets_in_[i]] ... targets_in_[offsets_in_[i+1]-1]
+ * the structure of the graph can't be changed, only the order of the edges of each node (see set_edges_in_topological_order)
+ */
+struct csr_graph {
+    std::vector<long long> offsets_out_;
+    std::vector<node_index> targets_out_;
+    std::vector<long long> offsets_in_;
+    std::vector<node_index> targets_in_;
+
+    csr_graph() : offsets_out_(1, 0), offsets_in_(1, 0) {}
+    explicit csr_graph(graph const& g);
+    // builds the incoming edges from the given outgoing edges
+    csr_graph(std::vector<long long> offsets_out, std::vector<node_index> targets_out);
+
+    long number_of_nodes() const {
+        return static_cast<long>(offsets_out_.size()) - 1;
+    }
+
+    long long number_of_edges() const {
+        return static_cast<long long>(targets_out_.size());
+    }
+
+    std::span<node_index const> outgoing_edges(node_index const id) const {
+        return {targets_out_.data() + offsets_out_[id], targets_out_.data() + offsets_out_[id+1]};
+    }
+
+    std::span<node_index const> incoming_edges(node_index const id) const {
+        return {targets_in_.data() + offsets_in_[id], targets_in_.data() + offsets_in_[id+1]};
+    }
+
+    bool operator==(csr_graph const& other) const = default;
+};
+
+inline long number_of_nodes(csr_graph const& g) {
+    return g.number_of_nodes();
+}
+
+inline std::span<node_index const> successors(csr_graph const& g, node_index const id) {
+    return g.outgoing_edges(id);
+}
+
+inline std::span<node_index const> predecessors(csr_graph const& g, node_index const id) {
+    return g.incoming_edges(id);
+}
+
+inline long out_degree(csr_graph const& g, node_index const id) {
+    return static_cast<long>(g.offsets_out_[id+1] - g.offsets_out_[id]);
+}
+
+inline long in_degree(csr_graph const& g, node_index const id) {
+    return static_cast<long>(g.offsets_in_[id+1] - g.offsets_in_[id]);
+}
+
+inline void prefetch_successors(csr_graph const& g, node_index const id) {
+    __builtin_prefetch(g.targets_out_.data() + g.offsets_out_[id]);
+}
+
+// returns a new csr_graph without the edges whose position in targets_out_ is marked in removed
+csr_graph remove_edges(csr_graph const& g, std::vector<bool> const& removed);
+
+graph to_graph(csr_graph const& g);
+
+} // namespace graphs
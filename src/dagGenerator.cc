@@ -102,7 +102,7 @@ graph generate_graph(long const number_of_nodes, long long const number_of_edges
     return dag;
 }
 
-std::vector<ConstEdge> generate_queries(graph const& dag, long long number_of_edges, std::vector<long> const& to_reverse) {
+std::vector<ConstEdge> generate_queries(graph const& dag, long long number_of_edges, std::vector<node_index> const& to_reverse) {
     std::uniform_int_distribution<long> node_distribution(0,dag.nodes_.size()-1);
     std::unordered_set<std::tuple<long, long>, hash_tuple>  existing_queries = {};
     std::vector<std::tuple<node const*, node const*>> generated_queries = {};
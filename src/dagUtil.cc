@@ -5,58 +5,74 @@
 #include <iostream>
 #include <stack>
 #include <queue>
+#include <stdexcept>
 
-/**
- * sorts the given dag in topological order and sets the id_ of each node to its position in the topological order
- * also sorts each nodes outgoing_edges in topological order and each nodes incoming_edges in reverse topological order
- * @param dag the directed acyclic graph
- */
-NodeOrder get_topological_order(graph& dag) {
+template <typename Graph>
+NodeOrder kahn_topological_order(Graph const& dag) {
     // the algorithm used for creating a topological order of nodes is Kahn's Algorithm
-    long num_of_nodes = dag.nodes_.size();
+    long num_of_nodes = number_of_nodes(dag);
 
-    std::vector<long> topological_order(num_of_nodes);
-    std::vector<long> topological_order_reverse(num_of_nodes);
-    std::queue<node const*> nodes_without_incoming_edge = {};
+    std::vector<node_index> topological_order(num_of_nodes);
+    std::vector<node_index> topological_order_reverse(num_of_nodes);
+    std::queue<node_index> nodes_without_incoming_edge = {};
     std::vector<long> num_of_visited_edges_for_node(num_of_nodes, 0); // this map keeps track of the number of visited edges by Kahn's Algorithm for each node
     long current_index = 0;
 
     // Look for all nodes that have no incoming edges and store them in nodes_without_incoming_edge
-    for(auto const& node : dag.nodes_) {
-        if(node.incoming_edges_.empty()) {
-            nodes_without_incoming_edge.push(&node);
+    for(long n = 0; n < num_of_nodes; ++n) {
+        if(in_degree(dag, n) == 0) {
+            nodes_without_incoming_edge.push(n);
         }
     }
     // Kahn's Algorithm
     while(!nodes_without_incoming_edge.empty()) {
         // get the last node n from the nodes without incoming edge
-        auto const& n = *nodes_without_incoming_edge.front();
+        auto const n = nodes_without_incoming_edge.front();
         nodes_without_incoming_edge.pop();
 
         // set the index of the current node
-        topological_order[n.id_] = current_index;
-        topological_order_reverse[current_index++] = n.id_;
+        topological_order[n] = current_index;
+        topological_order_reverse[current_index++] = n;
 
         // loop through each edge e of each node m that has an incoming edge from n to m
-        for(auto const outgoing_edge : n.outgoing_edges_) {
-            auto const& m = *outgoing_edge;
-
+        for(auto const m : successors(dag, n)) {
             // check if node m has no more incoming edges and if so add it to the topological order
-            if(++num_of_visited_edges_for_node[m.id_] == m.incoming_edges_.size()) {
-                nodes_without_incoming_edge.push(&m);
+            if(++num_of_visited_edges_for_node[m] == in_degree(dag, m)) {
+                nodes_without_incoming_edge.push(m);
             }
         }
     }
 
     // Check if the graph is a DAG
-    if (current_index != dag.nodes_.size()) {
+    if (current_index != num_of_nodes) {
         throw std::invalid_argument("the input graph is not a dag");
     }
 
     return std::make_tuple(topological_order, topological_order_reverse);
 }
 
-void set_edges_in_topological_order(graph& dag, std::vector<long> const& to) {
+/**
+ * computes a topological order of the given dag
+ * @param dag the directed acyclic graph
+ * @return a tuple of the topological index of each node and the node at each topological index
+ */
+NodeOrder get_topological_order(graph& dag) {
+    return kahn_topological_order(dag);
+}
+
+NodeOrder get_topological_order(csr_graph const& dag) {
+    return kahn_topological_order(dag);
+}
+
+NodeOrder get_topological_order(slab_graph const& dag) {
+    return kahn_topological_order(dag);
+}
+
+NodeOrder get_topological_order(compressed_graph const& dag) {
+    return kahn_topological_order(dag);
+}
+
+void set_edges_in_topological_order(graph& dag, std::vector<node_index> const& to) {
 
     // sort outgoing and incoming edges
     for(auto& n : dag.nodes_) {
@@ -66,6 +82,74 @@ void set_edges_in_topological_order(graph& dag, std::vector<long> const& to) {
 
 }
 
+void set_edges_in_topological_order(csr_graph& dag, std::vector<node_index> const& to) {
+
+    // sort outgoing and incoming edges of each node inside of their rows
+    for(long i = 0; i < dag.number_of_nodes(); ++i) {
+        std::sort(dag.targets_out_.begin() + dag.offsets_out_[i], dag.targets_out_.begin() + dag.offsets_out_[i+1], [&to](node_index const a, node_index const b) { return to[a] < to[b]; });
+        std::sort(dag.targets_in_.begin() + dag.offsets_in_[i], dag.targets_in_.begin() + dag.offsets_in_[i+1], [&to](node_index const a, node_index const b) { return to[a] > to[b]; });
+    }
+
+}
+
+// sorts the entries slab_[first] ... slab_[last-1] and keeps the twins of the moved entries pointing at them
+template <typename Compare>
+void sort_slab_range(slab_graph& dag, long long const first, long long const last, Compare const& compare) {
+    std::vector<std::tuple<long, long long>> entries; // (entry, twin)
+    entries.reserve(last - first);
+    for(auto p = first; p < last; ++p) {
+        entries.emplace_back(dag.slab_[p], dag.twin_[p]);
+    }
+    std::sort(entries.begin(), entries.end(), [&compare](auto const& a, auto const& b) { return compare(std::get<0>(a), std::get<0>(b)); });
+    for(auto p = first; p < last; ++p) {
+        auto const [entry, twin] = entries[p - first];
+        dag.slab_[p] = entry;
+        dag.twin_[p] = twin;
+        dag.twin_[twin] = p;
+    }
+}
+
+void set_edges_in_topological_order(slab_graph& dag, std::vector<node_index> const& to) {
+    dag.compact();
+
+    // sort outgoing and incoming edges of each node inside of their blocks
+    for(long i = 0; i < dag.number_of_nodes(); ++i) {
+        sort_slab_range(dag, dag.begin_[i], dag.middle_[i], [&to](node_index const a, node_index const b) { return to[a] < to[b]; });
+        sort_slab_range(dag, dag.middle_[i], dag.begin_[i+1], [&to](node_index const a, node_index const b) { return to[a] > to[b]; });
+    }
+
+}
+
+void set_edges_in_topological_order(compressed_graph& dag, std::vector<node_index> const& to) {
+    std::vector<std::uint8_t> bytes_out;
+    std::vector<std::uint8_t> bytes_in;
+    bytes_out.reserve(dag.bytes_out_.size());
+    bytes_in.reserve(dag.bytes_in_.size());
+    std::vector<node_index> row;
+
+    // decode, sort and encode each row again, the size of the encoded rows changes with their order
+    for(long i = 0; i < dag.number_of_nodes(); ++i) {
+        row.clear();
+        std::ranges::copy(dag.outgoing_edges(i), std::back_inserter(row));
+        std::sort(row.begin(), row.end(), [&to](node_index const a, node_index const b) { return to[a] < to[b]; });
+        dag.offsets_out_[i] = static_cast<long long>(bytes_out.size());
+        append_row(bytes_out, i, row);
+
+        row.clear();
+        std::ranges::copy(dag.incoming_edges(i), std::back_inserter(row));
+        std::sort(row.begin(), row.end(), [&to](node_index const a, node_index const b) { return to[a] > to[b]; });
+        dag.offsets_in_[i] = static_cast<long long>(bytes_in.size());
+        append_row(bytes_in, i, row);
+    }
+    dag.offsets_out_.back() = static_cast<long long>(bytes_out.size());
+    dag.offsets_in_.back() = static_cast<long long>(bytes_in.size());
+
+    bytes_out.shrink_to_fit();
+    bytes_in.shrink_to_fit();
+    dag.bytes_out_ = std::move(bytes_out);
+    dag.bytes_in_ = std::move(bytes_in);
+}
+
 std::unordered_set<node const*> find_all_reachable_nodes(node const& u, bool const include_root) {
     std::unordered_set<node const*> visited;
     std::stack<node const*> to_visit;
@@ -151,7 +235,7 @@ void shuffle_graph(graph& g, long const seed) {
 
     // Create a temporary vector to hold the shuffled nodes
     std::vector<node> shuffled_nodes(g.nodes_.size());
-    std::vector<long> new_indexes(g.nodes_.size());
+    std::vector<node_index> new_indexes(g.nodes_.size());
 
     // Update shuffled_nodes with the shuffled pointers and set their ids
     for (size_t i = 0; i < node_ptrs.size(); ++i) {
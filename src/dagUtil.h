@@ -1,14 +1,32 @@
+#pragma once
 #include "graphs.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
 
 #include <unordered_set>
 
 using namespace graphs;
 
-using NodeOrder = std::tuple<std::vector<long>, std::vector<long>>;
+using NodeOrder = std::tuple<std::vector<node_index>, std::vector<node_index>>;
 
 NodeOrder get_topological_order(graph&);
 
-void set_edges_in_topological_order(graph& dag, std::vector<long> const& to);
+NodeOrder get_topological_order(csr_graph const&);
+
+NodeOrder get_topological_order(slab_graph const&);
+
+NodeOrder get_topological_order(compressed_graph const&);
+
+void set_edges_in_topological_order(graph& dag, std::vector<node_index> const& to);
+
+void set_edges_in_topological_order(csr_graph& dag, std::vector<node_index> const& to);
+
+// compacts the slab before sorting the blocks
+void set_edges_in_topological_order(slab_graph& dag, std::vector<node_index> const& to);
+
+// re-encodes every row of the compressed graph
+void set_edges_in_topological_order(compressed_graph& dag, std::vector<node_index> const& to);
 
 bool all_nodes_edges_are_in_topological_order(graph const& graph);
 
@@ -1,16 +1,28 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 namespace graphs {
 
+// node ids, adjacency targets, DFS intervals and node orders are stored as node_index
+// building with COMPACT_NODE_INDICES switches them to 32 bit, which is enough for graphs with less than 2^31 nodes
+#ifdef COMPACT_NODE_INDICES
+using node_index = std::uint32_t;
+#else
+using node_index = long;
+#endif
+
 struct node {
 	std::vector<node*> outgoing_edges_;
 	std::vector<node*> incoming_edges_;
-    long id_;
+    node_index id_;
 
     node() : id_(0) {}
-    explicit node(long const index) : id_(index) {}
+    explicit node(node_index const index) : id_(index) {}
 
     bool operator==(node const& other) const {
         return id_ == other.id_;
@@ -30,7 +42,7 @@ struct graph {
         number_of_edges_ += 1;
     }
 
-    void add_edge(long const from, long const to) {
+    void add_edge(node_index const from, node_index const to) {
         add_edge(nodes_[from], nodes_[to]);
     }
 
@@ -40,7 +52,7 @@ struct graph {
         number_of_edges_ -= 1;
     }
 
-    void remove_edge(long const from, long const to) {
+    void remove_edge(node_index const from, node_index const to) {
         remove_edge(nodes_[from], nodes_[to]);
     }
 
@@ -66,6 +78,32 @@ struct graph {
     }
 };
 
+// id based accessors, these allow algorithms to be written once for graph and the other graph representations
+inline long number_of_nodes(graph const& g) {
+    return static_cast<long>(g.nodes_.size());
+}
+
+inline auto successors(graph const& g, node_index const id) {
+    return g.nodes_[id].outgoing_edges_ | std::views::transform([](node const* n) { return n->id_; });
+}
+
+inline auto predecessors(graph const& g, node_index const id) {
+    return g.nodes_[id].incoming_edges_ | std::views::transform([](node const* n) { return n->id_; });
+}
+
+inline long out_degree(graph const& g, node_index const id) {
+    return static_cast<long>(g.nodes_[id].outgoing_edges_.size());
+}
+
+inline long in_degree(graph const& g, node_index const id) {
+    return static_cast<long>(g.nodes_[id].incoming_edges_.size());
+}
+
+// prefetches what successors(g, id) reads first, so a search can fetch the edges of a node before it expands it
+inline void prefetch_successors(graph const& g, node_index const id) {
+    __builtin_prefetch(g.nodes_.data() + id);
+}
+
 using Edge = std::tuple<node*, node*>;
 using ConstEdge = std::tuple<node const*, node const*>;
 
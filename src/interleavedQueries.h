@@ -0,0 +1,98 @@
+#pragma once
+#include "graphs.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * one query in flight of run_interleaved_queries. pending_ is the node whose labels and edges were prefetched when
+ * it was popped, it is checked and expanded in the next step of the lane
+ */
+struct query_lane {
+    query_context context_;
+    std::size_t query_ = 0;
+    node_index target_ = 0;
+    node_index pending_ = 0;
+    bool active_ = false;
+};
+
+// how many queries run_interleaved_queries keeps in flight by default, each lane has its own visited stamps of 4 bytes per node
+inline constexpr std::size_t default_number_of_lanes = 8;
+
+/**
+ * answers the queries queries[positions[0]], queries[positions[1]], ... on the calling thread with one lane per query in flight.
+ * the lanes take turns doing one step each: a step checks the pending node of the lane, pushes its successors and prefetches
+ * their labels, then pops the next node and prefetches its edges. the lane only touches that node again after all
+ * other lanes made a step, so up to one cache miss per lane is in flight instead of one per thread.
+ * answer(position, reachable) is called for each query when it is finished, the queries finish in no particular order
+ */
+template <typename LabeledGraph, typename Answer>
+void run_interleaved_queries(LabeledGraph const& graph, std::span<std::tuple<node_index, node_index> const> const queries,
+                             std::span<std::size_t const> const positions, std::vector<query_lane>& lanes, Answer const& answer) {
+    auto const& g = graph.graph_;
+    auto const num_of_nodes = number_of_nodes(g);
+    std::size_t next = 0;
+
+    auto const start = [&](query_lane& lane) {
+        lane.active_ = next < positions.size();
+        if (!lane.active_) return;
+        lane.query_ = positions[next++];
+        auto const [u, v] = queries[lane.query_];
+        lane.target_ = v;
+        lane.pending_ = u;
+        lane.context_.begin_query(num_of_nodes);
+        lane.context_.visit(u);
+        prefetch_labels(graph, u);
+        prefetch_successors(g, u);
+    };
+
+    auto const step = [&](query_lane& lane) {
+        auto& context = lane.context_;
+        auto& stack = context.stack_;
+        auto const n = lane.pending_;
+
+        auto const check = check_labels(graph, n, lane.target_);
+        if (check == label_answer::reachable) {
+            answer(lane.query_, true);
+            start(lane);
+            return;
+        }
+        if (check == label_answer::unknown) {
+            auto const first_pushed = stack.size();
+            for (auto const w : successors(g, n)) {
+                if (context.is_visited(w)) continue;
+                context.visit(w);
+                prefetch_labels(graph, w);
+                stack.push_back(w);
+            }
+            // the first successor has to be on top of the stack
+            std::reverse(stack.begin() + first_pushed, stack.end());
+        }
+
+        if (stack.empty()) {
+            answer(lane.query_, false);
+            start(lane);
+            return;
+        }
+        lane.pending_ = stack.back();
+        stack.pop_back();
+        prefetch_successors(g, lane.pending_);
+    };
+
+    for (auto& lane : lanes) start(lane);
+    for (bool active = true; active;) {
+        active = false;
+        for (auto& lane : lanes) {
+            if (!lane.active_) continue;
+            step(lane);
+            active = true;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include "intervalLabelings.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
+
+namespace {
+
+// a node on the DFS stack, its children are children[begin_] ... children[end_-1] of which the ones before next_ are visited
+struct dfs_frame {
+    node_index node_;
+    std::size_t begin_;
+    std::size_t next_;
+    std::size_t end_;
+};
+
+} // namespace
+
+template <typename Graph>
+interval_labelings build_interval_labelings(Graph const& g, long const k, std::uint64_t const seed) {
+    auto const num_of_nodes = number_of_nodes(g);
+    interval_labelings labelings{k, std::vector<grail_interval>(num_of_nodes * k)};
+
+    std::vector<node_index> roots;
+    for (long n = 0; n < num_of_nodes; ++n) {
+        if (in_degree(g, n) == 0) roots.push_back(n);
+    }
+
+    std::vector<bool> visited(num_of_nodes);
+    std::vector<node_index> children;
+    std::vector<dfs_frame> stack;
+
+    for (long i = 0; i < k; ++i) {
+        std::mt19937_64 gen(seed + i);
+        auto const order = [i, &gen](auto const first, auto const last) {
+            if (i == 0) std::reverse(first, last);
+            else std::shuffle(first, last, gen);
+        };
+        auto const label = [&labelings, i](node_index const n) -> grail_interval& { return labelings.intervals_[n * labelings.k_ + i]; };
+
+        std::fill(visited.begin(), visited.end(), false);
+        long discovery = 0;
+        long finish = 0;
+
+        auto const visit = [&](node_index const n) {
+            visited[n] = true;
+            label(n) = {static_cast<node_index>(discovery++), 0, std::numeric_limits<node_index>::max()};
+            auto const first_child = children.size();
+            for (auto const m : successors(g, n)) children.push_back(m);
+            order(children.begin() + first_child, children.end());
+            stack.push_back({n, first_child, first_child, children.size()});
+        };
+
+        order(roots.begin(), roots.end());
+        for (auto const root : roots) {
+            visit(root);
+            while (!stack.empty()) {
+                auto& frame = stack.back();
+                if (frame.next_ < frame.end_) {
+                    auto const child = children[frame.next_++];
+                    if (visited[child]) { // in a DAG the child is already finished, so its low is final
+                        label(frame.node_).low_ = std::min(label(frame.node_).low_, label(child).low_);
+                    } else {
+                        visit(child);
+                    }
+                    continue;
+                }
+
+                // the children of all descendants are already removed, so the ones of this node are at the end
+                children.resize(frame.begin_);
+                auto& interval = label(frame.node_);
+                interval.finish_ = static_cast<node_index>(finish++);
+                interval.low_ = std::min(interval.low_, interval.finish_);
+                stack.pop_back();
+                if (!stack.empty()) {
+                    auto& parent = label(stack.back().node_);
+                    parent.low_ = std::min(parent.low_, interval.low_);
+                }
+            }
+        }
+    }
+
+    return labelings;
+}
+
+template interval_labelings build_interval_labelings(graph const&, long, std::uint64_t);
+template interval_labelings build_interval_labelings(csr_graph const&, long, std::uint64_t);
+template interval_labelings build_interval_labelings(slab_graph const&, long, std::uint64_t);
+template interval_labelings build_interval_labelings(compressed_graph const&, long, std::uint64_t);
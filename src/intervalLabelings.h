@@ -0,0 +1,45 @@
+#pragma once
+#include "graphs.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace graphs;
+
+// the intervals of a node in one labeling, discovery_ and finish_ are its pre and post order rank in the DFS forest
+// and low_ is the smallest post order rank of all nodes reachable from it
+struct grail_interval {
+    node_index discovery_;
+    node_index finish_;
+    node_index low_;
+};
+
+/**
+ * k independent interval labelings (GRAIL), each from a DFS with a different child order: the first one visits the roots
+ * and children in reversed order, the others in random orders. the intervals of a node are stored next to each other
+ */
+struct interval_labelings {
+    long k_ = 0;
+    std::vector<grail_interval> intervals_;
+
+    grail_interval const* of(node_index const n) const {
+        return intervals_.data() + n * k_;
+    }
+};
+
+template <typename Graph>
+interval_labelings build_interval_labelings(Graph const& g, long k, std::uint64_t seed = 12092024);
+
+/**
+ * returns 1 if u reaches v along the DFS forest of one of the labelings, -1 if the GRAIL interval of v is not contained
+ * in the one of u in one of the labelings, which means u can not reach v, and 0 otherwise
+ */
+inline int check_interval_labelings(interval_labelings const& labelings, node_index const u, node_index const v) {
+    auto const* intervals_u = labelings.of(u);
+    auto const* intervals_v = labelings.of(v);
+    for (long i = 0; i < labelings.k_; ++i) {
+        if (intervals_v[i].finish_ > intervals_u[i].finish_ || intervals_v[i].low_ < intervals_u[i].low_) return -1;
+        if (intervals_u[i].discovery_ <= intervals_v[i].discovery_) return 1; // together with the finish check, v is in the subtree of u
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "graphs.h"
+#include "labelKernels.h"
+#include "memoryPolicy.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+using namespace graphs;
+
+// the DFS interval of a node, both values are needed together by every query
+struct interval {
+    node_index discovery_;
+    node_index finish_;
+};
+
+/**
+ * holds all labels of a labeled_graph in one 64 byte aligned allocation, which is split into three 64 byte aligned sections:
+ * the intervals of all nodes, the label_out words of all nodes and the label_in words of all nodes.
+ * the allocation is backed according to the memory policy (huge pages, NUMA placement).
+ * the bit b of a label is stored as bit b % 64 of its word b / 64. the arena is zeroed, so an empty label means unvisited
+ */
+template <size_t hash_range>
+struct label_arena {
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t words_per_label = (hash_range + 63) / 64;
+
+    std::unique_ptr<std::byte, policy_deleter> memory_;
+    interval* intervals_;
+    std::uint64_t* label_out_;
+    std::uint64_t* label_in_;
+
+    explicit label_arena(long const number_of_nodes) {
+        auto const intervals_size = round_up(number_of_nodes * sizeof(interval));
+        auto const labels_size = round_up(number_of_nodes * words_per_label * sizeof(std::uint64_t));
+        auto const size = std::max<std::size_t>(intervals_size + 2 * labels_size, alignment);
+
+        memory_.reset(static_cast<std::byte*>(allocate_memory(size)));
+
+        intervals_ = reinterpret_cast<interval*>(memory_.get());
+        label_out_ = reinterpret_cast<std::uint64_t*>(memory_.get() + intervals_size);
+        label_in_ = reinterpret_cast<std::uint64_t*>(memory_.get() + intervals_size + labels_size);
+    }
+
+    std::uint64_t* out(node_index const n) const {
+        return label_out_ + n * words_per_label;
+    }
+
+    std::uint64_t* in(node_index const n) const {
+        return label_in_ + n * words_per_label;
+    }
+
+    static std::size_t round_up(std::size_t const size) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+};
+
+// label word helpers, a label consists of label_arena<hash_range>::words_per_label words
+template <size_t hash_range>
+void set_label_bit(std::uint64_t* label, std::size_t const bit) {
+    label[bit / 64] |= std::uint64_t{1} << (bit % 64);
+}
+
+template <size_t hash_range>
+bool label_is_empty(std::uint64_t const* label) {
+    for (std::size_t i = 0; i < label_arena<hash_range>::words_per_label; ++i) {
+        if (label[i] != 0) return false;
+    }
+    return true;
+}
+
+// label = label union other
+template <size_t hash_range>
+void unite_labels(std::uint64_t* label, std::uint64_t const* other) {
+    for (std::size_t i = 0; i < label_arena<hash_range>::words_per_label; ++i) {
+        label[i] |= other[i];
+    }
+}
+
+// returns whether subset is a subset of superset
+template <size_t hash_range>
+bool label_is_subset(std::uint64_t const* subset, std::uint64_t const* superset) {
+    for (std::size_t i = 0; i < label_arena<hash_range>::words_per_label; ++i) {
+        if (subset[i] & ~superset[i]) return false;
+    }
+    return true;
+}
+
+// returns whether out_subset is a subset of out_superset and in_subset is a subset of in_superset,
+// labels of less than 4 words are tested inline, longer ones with the SIMD kernel of the cpu
+template <size_t hash_range>
+bool labels_are_subsets(std::uint64_t const* out_subset, std::uint64_t const* out_superset, std::uint64_t const* in_subset, std::uint64_t const* in_superset) {
+    if constexpr (label_arena<hash_range>::words_per_label < 4) {
+        for (std::size_t i = 0; i < label_arena<hash_range>::words_per_label; ++i) {
+            if ((out_subset[i] & ~out_superset[i]) | (in_subset[i] & ~in_superset[i])) return false;
+        }
+        return true;
+    } else {
+        return labels_are_subsets(out_subset, out_superset, in_subset, in_superset, label_arena<hash_range>::words_per_label);
+    }
+}
+
+// prefetches all cache lines of a label for reading
+template <size_t hash_range>
+void prefetch_label(std::uint64_t const* label) {
+    for (std::size_t i = 0; i < label_arena<hash_range>::words_per_label; i += 8) {
+        __builtin_prefetch(label + i);
+    }
+}
+
+// read access to the discovery or the finish value of each node, e.g. label_discovery_[n]
+struct interval_field_view {
+    interval const* intervals_;
+    node_index interval::* field_;
+
+    node_index operator[](node_index const n) const {
+        return intervals_[n].*field_;
+    }
+};
+
+// read access to the labels of each node as bitsets, e.g. label_out_[n]
+template <size_t hash_range>
+struct label_view {
+    std::uint64_t const* words_;
+
+    std::bitset<hash_range> operator[](node_index const n) const {
+        std::bitset<hash_range> label;
+        auto const* words = words_ + n * label_arena<hash_range>::words_per_label;
+        for (std::size_t bit = 0; bit < hash_range; ++bit) {
+            label[bit] = (words[bit / 64] >> (bit % 64)) & 1;
+        }
+        return label;
+    }
+};
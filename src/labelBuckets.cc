@@ -0,0 +1,27 @@
+#include "labelBuckets.h"
+
+#include <functional>
+#include <queue>
+#include <utility>
+
+bucket_array balance_buckets(std::vector<node_index> const& post_order, std::vector<node_index> const& groups, std::size_t const hash_range) {
+    std::vector<long> group_size(post_order.size(), 0);
+    for (auto const n : post_order) ++group_size[groups[n]];
+
+    // the bucket with the fewest nodes on top, ties go to the smaller bucket, so equal groups are placed round robin
+    std::priority_queue<std::pair<long, std::size_t>, std::vector<std::pair<long, std::size_t>>, std::greater<>> populations;
+    for (std::size_t bucket = 0; bucket < hash_range; ++bucket) populations.emplace(0, bucket);
+
+    bucket_array buckets(post_order.size());
+    for (auto const n : post_order) {
+        if (groups[n] != n) {
+            buckets[n] = buckets[groups[n]];
+            continue;
+        }
+        auto const [population, bucket] = populations.top();
+        populations.pop();
+        buckets[n] = static_cast<std::uint16_t>(bucket);
+        populations.emplace(population + group_size[n], bucket);
+    }
+    return buckets;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "graphs.h"
+#include "MurmurHash3.h"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace graphs;
+
+// the bucket of each node, i.e. the bit the node sets in its own label_in and label_out
+using bucket_array = std::vector<std::uint16_t>;
+
+// merges the nodes into d groups of consecutive nodes in post order, returns the first node of the group of each node
+std::vector<node_index> merge_vertices(std::vector<node_index> const& post_order, long d);
+
+// the bucket of a merged node is the existing MurmurHash3 of its first node, reduced to the range
+template <size_t hash_range>
+struct murmur_hash {
+    std::uint64_t operator()(node_index const id) const {
+        return murmur3_64(id) % hash_range;
+    }
+};
+
+// the bucket of a merged node are the high bits of its first node times an odd constant, which is one multiplication
+template <size_t hash_range>
+struct multiply_shift_hash {
+    static_assert(hash_range >= 2 && std::has_single_bit(hash_range), "multiply_shift_hash needs a power of two as range");
+
+    std::uint64_t operator()(node_index const id) const {
+        return (static_cast<std::uint64_t>(id) * 0x9e3779b97f4a7c15ull) >> (64 - std::countr_zero(hash_range));
+    }
+};
+
+/**
+ * the groups of merge_vertices are placed in post order, each into the bucket with the fewest nodes so far, so every
+ * bucket holds about the same number of nodes. merge_vertices puts the remainder of n / d into its last group, which
+ * can hold up to half of the nodes, the other buckets are then shared by the other groups
+ */
+struct balanced_buckets {};
+
+// a hash policy maps the first node of a merged group to its bucket in 0...hash_range-1
+template <typename Policy>
+concept hash_policy = std::invocable<Policy const&, node_index> && std::integral<std::invoke_result_t<Policy const&, node_index>>;
+
+template <typename Policy>
+concept bucket_policy = hash_policy<Policy> || std::same_as<Policy, balanced_buckets>;
+
+bucket_array balance_buckets(std::vector<node_index> const& post_order, std::vector<node_index> const& groups, std::size_t hash_range);
+
+/**
+ * the bucket of every node for labels of hash_range bits, merged by merge_vertices(post_order, d) first.
+ * a hash policy is called once per group, the other nodes of the group copy the bucket of its first node
+ */
+template <size_t hash_range, bucket_policy Policy>
+bucket_array assign_buckets(std::vector<node_index> const& post_order, long const d, Policy const& policy) {
+    static_assert(hash_range <= 1 << 16, "the buckets are stored in 16 bits");
+    auto const groups = merge_vertices(post_order, d);
+    if constexpr (std::same_as<Policy, balanced_buckets>) {
+        return balance_buckets(post_order, groups, hash_range);
+    } else {
+        bucket_array buckets(post_order.size());
+        // the first node of a group comes first in post order
+        for (auto const n : post_order) {
+            buckets[n] = groups[n] == n ? static_cast<std::uint16_t>(policy(n)) : buckets[groups[n]];
+        }
+        return buckets;
+    }
+}
+
+// how the TR engines assign the buckets of the labels
+enum class bucket_assignment {
+    murmur,         // murmur_hash
+    multiply_shift, // multiply_shift_hash
+    balanced        // balanced_buckets
+};
+
+// calls f with the policy of the given assignment, so the builders of the labels are instantiated for each policy
+template <size_t hash_range, typename F>
+decltype(auto) with_bucket_policy(bucket_assignment const assignment, F&& f) {
+    switch (assignment) {
+        case bucket_assignment::murmur: return f(murmur_hash<hash_range>{});
+        case bucket_assignment::multiply_shift: return f(multiply_shift_hash<hash_range>{});
+        case bucket_assignment::balanced: return f(balanced_buckets{});
+        default: throw std::invalid_argument("unknown bucket assignment");
+    }
+}
+
+// the buckets of the policy the assignment names, so the labels are filled the same way for every policy
+template <size_t hash_range>
+bucket_array assign_buckets(std::vector<node_index> const& post_order, long const d, bucket_assignment const assignment) {
+    return with_bucket_policy<hash_range>(assignment, [&](auto const& policy) { return assign_buckets<hash_range>(post_order, d, policy); });
+}
+
+// what the builders of the labels accept to assign the buckets: a policy or an assignment chosen at runtime
+template <typename Buckets>
+concept bucket_source = bucket_policy<Buckets> || std::same_as<Buckets, bucket_assignment>;
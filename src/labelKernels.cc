@@ -0,0 +1,110 @@
+#include "labelKernels.h"
+
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LABEL_KERNELS_X86
+#endif
+
+namespace {
+
+using kernel_function = bool (*)(std::uint64_t const*, std::uint64_t const*, std::uint64_t const*, std::uint64_t const*, std::size_t);
+
+bool labels_are_subsets_scalar(std::uint64_t const* out_subset, std::uint64_t const* out_superset,
+                               std::uint64_t const* in_subset, std::uint64_t const* in_superset, std::size_t const words) {
+    for (std::size_t i = 0; i < words; ++i) {
+        if ((out_subset[i] & ~out_superset[i]) | (in_subset[i] & ~in_superset[i])) return false;
+    }
+    return true;
+}
+
+#ifdef LABEL_KERNELS_X86
+__attribute__((target("avx2")))
+bool labels_are_subsets_avx2(std::uint64_t const* out_subset, std::uint64_t const* out_superset,
+                             std::uint64_t const* in_subset, std::uint64_t const* in_superset, std::size_t const words) {
+    std::size_t i = 0;
+    for (; i + 4 <= words; i += 4) {
+        auto const out_violations = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(out_superset + i)),
+                                                        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(out_subset + i)));
+        auto const in_violations = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_superset + i)),
+                                                       _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_subset + i)));
+        auto const violations = _mm256_or_si256(out_violations, in_violations);
+        if (!_mm256_testz_si256(violations, violations)) return false;
+    }
+    return labels_are_subsets_scalar(out_subset + i, out_superset + i, in_subset + i, in_superset + i, words - i);
+}
+
+__attribute__((target("avx512f")))
+bool labels_are_subsets_avx512(std::uint64_t const* out_subset, std::uint64_t const* out_superset,
+                               std::uint64_t const* in_subset, std::uint64_t const* in_superset, std::size_t const words) {
+    std::size_t i = 0;
+    for (; i + 8 <= words; i += 8) {
+        // the masks of the words in which subset & superset != subset
+        auto const out_subset_words = _mm512_loadu_si512(out_subset + i);
+        auto const in_subset_words = _mm512_loadu_si512(in_subset + i);
+        auto const out_violations = _mm512_cmpneq_epi64_mask(_mm512_and_si512(out_subset_words, _mm512_loadu_si512(out_superset + i)), out_subset_words);
+        auto const in_violations = _mm512_cmpneq_epi64_mask(_mm512_and_si512(in_subset_words, _mm512_loadu_si512(in_superset + i)), in_subset_words);
+        if (out_violations | in_violations) return false;
+    }
+    return labels_are_subsets_avx2(out_subset + i, out_superset + i, in_subset + i, in_superset + i, words - i);
+}
+#endif
+
+kernel_function kernel_function_of(label_kernel const kernel) {
+    switch (kernel) {
+#ifdef LABEL_KERNELS_X86
+        case label_kernel::avx2:
+            return labels_are_subsets_avx2;
+        case label_kernel::avx512:
+            return labels_are_subsets_avx512;
+#endif
+        default:
+            return labels_are_subsets_scalar;
+    }
+}
+
+// set once at startup, so a query only pays an indirect call
+label_kernel current_kernel = best_label_kernel();
+kernel_function current_kernel_function = kernel_function_of(current_kernel);
+
+} // namespace
+
+bool is_supported(label_kernel const kernel) {
+#ifdef LABEL_KERNELS_X86
+    __builtin_cpu_init(); // the kernel can be chosen by static initialization before the cpu features are initialized
+#endif
+    switch (kernel) {
+#ifdef LABEL_KERNELS_X86
+        case label_kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+        case label_kernel::avx512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        case label_kernel::scalar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+label_kernel best_label_kernel() {
+    if (is_supported(label_kernel::avx512)) return label_kernel::avx512;
+    if (is_supported(label_kernel::avx2)) return label_kernel::avx2;
+    return label_kernel::scalar;
+}
+
+label_kernel get_label_kernel() {
+    return current_kernel;
+}
+
+void set_label_kernel(label_kernel const kernel) {
+    if (!is_supported(kernel)) throw std::invalid_argument("the cpu does not support the label kernel");
+    current_kernel = kernel;
+    current_kernel_function = kernel_function_of(kernel);
+}
+
+bool labels_are_subsets(std::uint64_t const* out_subset, std::uint64_t const* out_superset,
+                        std::uint64_t const* in_subset, std::uint64_t const* in_superset, std::size_t const words) {
+    return current_kernel_function(out_subset, out_superset, in_subset, in_superset, words);
+}
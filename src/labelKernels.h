@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// the implementations of the fused subset test of label_out and label_in, chosen at runtime by the cpu features
+enum class label_kernel {
+    scalar,
+    avx2,
+    avx512
+};
+
+// the fastest kernel the cpu supports, it is used unless set_label_kernel selects another one
+label_kernel best_label_kernel();
+
+bool is_supported(label_kernel kernel);
+
+label_kernel get_label_kernel();
+
+// throws std::invalid_argument if the cpu does not support the kernel
+void set_label_kernel(label_kernel kernel);
+
+/**
+ * returns whether out_subset is a subset of out_superset and in_subset is a subset of in_superset,
+ * each label consists of words words. both tests are done in one pass, which stops at the first word that violates one of them
+ */
+bool labels_are_subsets(std::uint64_t const* out_subset, std::uint64_t const* out_superset,
+                        std::uint64_t const* in_subset, std::uint64_t const* in_superset, std::size_t words);
@@ -0,0 +1,61 @@
+#pragma once
+#include "labelBuckets.h"
+#include "reachabilitySearch.h"
+#include "redundancyCheck.h"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+struct tuning_report;
+
+// the label widths for which the TR engines are instantiated
+inline constexpr std::array<std::size_t, 6> supported_hash_ranges{64, 128, 256, 512, 1024, 2048};
+
+/**
+ * the parameters of the labels the TR engines build, chosen at runtime:
+ * hash_range_ is the width of label_in and label_out (one of supported_hash_ranges), d_ the merge distance of merge_vertices
+ * and memory_budget_ the number of bytes the labels may use (0 means the labels are not budgeted).
+ * number_of_interval_labelings_ is the number of additional GRAIL interval labelings, which are not used by budgeted labels.
+ * search_direction_ is the direction of the queries of the id based tr_o_plus versions.
+ * redundancy_check_ is how the id based tr_o_plus versions check an edge, the search direction only applies to per_witness.
+ * per_source is only supported by the csr_graph and compressed_graph versions, the slab_graph version checks per witness
+ * instead.
+ * bucket_assignment_ is the policy that assigns the bit of each merged node in the labels, see assign_buckets.
+ * if auto_tune_ is set, the engines replace hash_range_ and d_ by the ones tune_label_parameters chooses for the graph
+ * and write the report of the tuning to tuning_report_ unless it is null, so the caller can print what was chosen
+ */
+struct label_parameters {
+    std::size_t hash_range_ = 1024;
+    long d_ = 1024 * 10;
+    std::size_t memory_budget_ = 0;
+    long number_of_interval_labelings_ = 0;
+    search_direction search_direction_ = search_direction::forward;
+    redundancy_check redundancy_check_ = redundancy_check::per_witness;
+    bucket_assignment bucket_assignment_ = bucket_assignment::murmur;
+    bool auto_tune_ = false;
+    tuning_report* tuning_report_ = nullptr;
+
+    // the parameters the engines used before hash_range became a runtime parameter, d is 10 times the hash range
+    static label_parameters for_hash_range(std::size_t const hash_range) {
+        label_parameters parameters;
+        parameters.hash_range_ = hash_range;
+        parameters.d_ = static_cast<long>(hash_range) * 10;
+        return parameters;
+    }
+};
+
+// calls f with std::integral_constant<std::size_t, hash_range>, so f can instantiate labeled_graph<hash_range>
+template <typename F>
+decltype(auto) with_hash_range(std::size_t const hash_range, F&& f) {
+    switch (hash_range) {
+        case 64: return f(std::integral_constant<std::size_t, 64>{});
+        case 128: return f(std::integral_constant<std::size_t, 128>{});
+        case 256: return f(std::integral_constant<std::size_t, 256>{});
+        case 512: return f(std::integral_constant<std::size_t, 512>{});
+        case 1024: return f(std::integral_constant<std::size_t, 1024>{});
+        case 2048: return f(std::integral_constant<std::size_t, 2048>{});
+        default: throw std::invalid_argument("the TR engines are not instantiated for this hash_range");
+    }
+}
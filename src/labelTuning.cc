@@ -0,0 +1,188 @@
+#include "labelTuning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+#include "BFL.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "dagUtil.h"
+#include "queryContext.h"
+#include "redundancyCheck.h"
+#include "slabGraph.h"
+
+namespace {
+
+// the intervals, label_in and label_out of all nodes as label_arena stores them, hash_range is one of supported_hash_ranges
+std::size_t label_memory_in_bytes(long const num_of_nodes, std::size_t const hash_range) {
+    return with_hash_range(hash_range, [num_of_nodes](auto const width) {
+        return num_of_nodes * (sizeof(interval) + 2 * label_arena<decltype(width)::value>::words_per_label * sizeof(std::uint64_t));
+    });
+}
+
+long microseconds_since(std::chrono::high_resolution_clock::time_point const start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * builds the labels of the candidate for graph, whose edges are in topological order, and runs the sampled workload:
+ * the outgoing edges of the sampled sources are checked for redundancy and the labels are asked for the sampled queries.
+ * the check time is scaled to all nodes of the graph
+ */
+template <size_t hash_range, typename Graph>
+tuning_candidate measure_candidate(Graph const& graph, bucket_assignment const assignment, long const d, std::vector<node_index> const& sources,
+                                   std::vector<std::tuple<node_index, node_index>> const& queries) {
+    auto const num_of_nodes = number_of_nodes(graph);
+    tuning_candidate candidate{hash_range, d, 0, 0, 0.0, 0};
+    candidate.memory_in_bytes_ = label_memory_in_bytes(num_of_nodes, hash_range);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto const labeled_graph = build_labeled_graph<hash_range>(graph, assignment, d);
+    candidate.build_microseconds_ = microseconds_since(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    query_context context;
+    long redundant = 0;
+    for (auto const u : sources) {
+        find_redundant_out_edges(labeled_graph, u, context, [&redundant](std::size_t, node_index) { ++redundant; });
+    }
+    candidate.check_microseconds_ = sources.empty() ? 0 : microseconds_since(start) * num_of_nodes / static_cast<long>(sources.size());
+
+    long decided = 0;
+    for (auto const& [u, v] : queries) {
+        decided += check_labels(labeled_graph, u, v) != label_answer::unknown;
+    }
+    candidate.pruning_rate_ = queries.empty() ? 1.0 : static_cast<double>(decided) / static_cast<double>(queries.size());
+    return candidate;
+}
+
+// a copy of graph as csr_graph, whose edges can be sorted in topological order without changing graph
+template <typename Graph>
+csr_graph copy_to_csr_graph(Graph const& graph) {
+    std::vector<long long> offsets_out(number_of_nodes(graph) + 1, 0);
+    std::vector<node_index> targets_out;
+    for (long n = 0; n < number_of_nodes(graph); ++n) {
+        for (auto const w : successors(graph, n)) targets_out.push_back(w);
+        offsets_out[n + 1] = static_cast<long long>(targets_out.size());
+    }
+    return csr_graph(std::move(offsets_out), std::move(targets_out));
+}
+
+long estimated_microseconds(tuning_candidate const& candidate) {
+    return candidate.build_microseconds_ + candidate.check_microseconds_;
+}
+
+template <typename Graph>
+tuning_report tune_sorted(Graph const& graph, std::vector<node_index> const& to_reverse, tuning_options const& options, label_parameters const& defaults) {
+    auto const num_of_nodes = number_of_nodes(graph);
+    tuning_report report{defaults, 0, {}};
+    report.chosen_.auto_tune_ = false;
+    if (num_of_nodes == 0) return report;
+
+    std::mt19937_64 gen(options.seed_);
+    std::uniform_int_distribution<long> random_node(0, num_of_nodes - 1);
+    std::vector<node_index> sources;
+    for (long i = 0; i < std::min(options.number_of_sources_, num_of_nodes); ++i) {
+        sources.push_back(num_of_nodes <= options.number_of_sources_ ? i : random_node(gen));
+    }
+    // from u to a node v after u in the topological order, the others are denied by the order filters alone
+    std::vector<std::tuple<node_index, node_index>> queries;
+    for (long i = 0; i < options.number_of_queries_ && num_of_nodes > 1; ++i) {
+        auto const a = random_node(gen);
+        auto const b = random_node(gen);
+        if (a != b) queries.emplace_back(to_reverse[std::min(a, b)], to_reverse[std::max(a, b)]);
+    }
+    report.number_of_sources_ = static_cast<long>(sources.size());
+
+    auto const memory_limit = options.memory_limit_ != 0 ? options.memory_limit_ : label_memory_in_bytes(num_of_nodes, label_parameters{}.hash_range_);
+    auto const measure = [&](std::size_t const hash_range, long const d) -> tuning_candidate const* {
+        if (label_memory_in_bytes(num_of_nodes, hash_range) > memory_limit) return nullptr;
+        report.candidates_.push_back(with_hash_range(hash_range, [&](auto const width) {
+            return measure_candidate<decltype(width)::value>(graph, defaults.bucket_assignment_, d, sources, queries);
+        }));
+        return &report.candidates_.back();
+    };
+    report.candidates_.reserve(supported_hash_ranges.size() + options.d_factors_.size());
+
+    // first the hash ranges with d = 10 * hash_range from small to large, until two larger ones in a row were slower
+    std::size_t best_hash_range = 0;
+    long best = 0;
+    int slower = 0;
+    for (auto const hash_range : supported_hash_ranges) {
+        auto const candidate = measure(hash_range, 10 * static_cast<long>(hash_range));
+        if (candidate == nullptr) break;
+        if (best_hash_range == 0 || estimated_microseconds(*candidate) < best) {
+            best_hash_range = hash_range;
+            best = estimated_microseconds(*candidate);
+            slower = 0;
+        } else if (++slower == 2) {
+            break;
+        }
+    }
+    if (best_hash_range == 0) throw std::invalid_argument("the memory limit is too small for the labels of the graph");
+
+    // then the other values of d for the best hash range
+    for (auto const factor : options.d_factors_) {
+        if (factor != 10) measure(best_hash_range, factor * static_cast<long>(best_hash_range));
+    }
+
+    // the candidates within time_tolerance_ of the fastest one are as fast as it given the noise of the measurement,
+    // of them the one with the highest pruning rate is chosen and of equal rates the one with the smallest labels
+    auto const fastest = estimated_microseconds(*std::min_element(report.candidates_.begin(), report.candidates_.end(), [](tuning_candidate const& a, tuning_candidate const& b) {
+        return estimated_microseconds(a) < estimated_microseconds(b);
+    }));
+    tuning_candidate const* chosen = nullptr;
+    for (auto const& candidate : report.candidates_) {
+        if (static_cast<double>(estimated_microseconds(candidate)) > static_cast<double>(fastest) * (1.0 + options.time_tolerance_)) continue;
+        if (chosen == nullptr || candidate.pruning_rate_ > chosen->pruning_rate_
+            || (candidate.pruning_rate_ == chosen->pruning_rate_ && candidate.memory_in_bytes_ < chosen->memory_in_bytes_)) {
+            chosen = &candidate;
+        }
+    }
+    report.chosen_.hash_range_ = chosen->hash_range_;
+    report.chosen_.d_ = chosen->d_;
+    return report;
+}
+
+} // namespace
+
+template <typename Graph>
+tuning_report tune_label_parameters(Graph const& graph, tuning_options const& options, label_parameters const& defaults) {
+    // the witnesses of the redundancy checks need the edges in topological order
+    auto sorted = copy_to_csr_graph(graph);
+    auto const [to, to_reverse] = get_topological_order(sorted);
+    set_edges_in_topological_order(sorted, to);
+    return tune_sorted(sorted, to_reverse, options, defaults);
+}
+
+void print_tuning_report(tuning_report const& report, std::ostream& out) {
+    out << "tuned with the outgoing edges of " << report.number_of_sources_ << " sampled sources\n";
+    for (auto const& candidate : report.candidates_) {
+        out << "hash_range " << candidate.hash_range_ << " d " << candidate.d_
+            << ": build " << candidate.build_microseconds_ << " microseconds, check " << candidate.check_microseconds_
+            << " microseconds, pruning rate " << candidate.pruning_rate_ << ", memory " << candidate.memory_in_bytes_ << " bytes\n";
+    }
+    out << "chosen: hash_range " << report.chosen_.hash_range_ << " d " << report.chosen_.d_ << "\n";
+}
+
+// the labels of the chosen candidate are not reused by the engines: they were built on the sorted csr_graph copy of
+// the tuning and refer to it, while the engines build them on their own graph, with interval labelings or a memory budget
+template <typename Graph>
+label_parameters resolve_label_parameters(Graph const& graph, label_parameters const& parameters) {
+    if (!parameters.auto_tune_) return parameters;
+    auto report = tune_label_parameters(graph, tuning_options{}, parameters);
+    if (parameters.tuning_report_ != nullptr) *parameters.tuning_report_ = report;
+    return report.chosen_;
+}
+
+template tuning_report tune_label_parameters(graph const&, tuning_options const&, label_parameters const&);
+template tuning_report tune_label_parameters(csr_graph const&, tuning_options const&, label_parameters const&);
+template tuning_report tune_label_parameters(slab_graph const&, tuning_options const&, label_parameters const&);
+template tuning_report tune_label_parameters(compressed_graph const&, tuning_options const&, label_parameters const&);
+
+template label_parameters resolve_label_parameters(graph const&, label_parameters const&);
+template label_parameters resolve_label_parameters(csr_graph const&, label_parameters const&);
+template label_parameters resolve_label_parameters(slab_graph const&, label_parameters const&);
+template label_parameters resolve_label_parameters(compressed_graph const&, label_parameters const&);
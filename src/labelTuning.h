@@ -0,0 +1,60 @@
+#pragma once
+#include "graphs.h"
+#include "labelParameters.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace graphs;
+
+// how tune_label_parameters samples the workload and which candidates it measures
+struct tuning_options {
+    long number_of_sources_ = 2000;           // the number of random nodes whose outgoing edges are checked for redundancy
+    long number_of_queries_ = 20000;          // the number of random queries that measure the pruning rate
+    std::vector<long> d_factors_{1, 10, 100}; // the d of a candidate is its hash_range times one of these
+    std::size_t memory_limit_ = 0;            // the number of bytes the labels may use, 0 means the labels the engines build without tuning
+    double time_tolerance_ = 0.05;            // the candidates at most this much slower than the fastest one count as equally fast
+    std::uint64_t seed_ = 12092024;
+};
+
+// what the sampled workload measured for one candidate
+struct tuning_candidate {
+    std::size_t hash_range_;
+    long d_;
+    long build_microseconds_;     // building the labels
+    long check_microseconds_;     // checking the outgoing edges of the sampled sources, scaled to all nodes
+    double pruning_rate_;         // the share of the sampled queries the labels decide without a search
+    std::size_t memory_in_bytes_; // of the intervals and the labels
+};
+
+// the chosen parameters and every candidate they were chosen from
+struct tuning_report {
+    label_parameters chosen_;
+    long number_of_sources_;
+    std::vector<tuning_candidate> candidates_;
+};
+
+/**
+ * chooses hash_range_ and d_ of the labels of graph by a sampled workload: each candidate is built for graph, then the
+ * outgoing edges of number_of_sources_ random nodes are checked for redundancy as tr_o_plus does, which is scaled to all
+ * nodes, and random queries count how many of them the labels decide. of the candidates whose build and check
+ * time is within time_tolerance_ of the fastest one, the one with the highest pruning rate and then the smallest labels
+ * is chosen, the other parameters are kept from defaults.
+ * the hash ranges are measured from small to large with d = 10 * hash_range until two in a row were slower than the best
+ * one or do not fit into memory_limit_, then the other d_factors_ are measured for the best hash range.
+ * the candidates are built on the whole graph one after another, so the tuning needs the memory of the largest candidate.
+ * by default that is at most the memory of the labels of label_parameters{}.hash_range_, which the engines build without
+ * tuning, so larger hash ranges are only measured with an explicit memory_limit_ (std::numeric_limits<std::size_t>::max()
+ * for no limit). throws std::invalid_argument if not even the smallest hash range fits
+ */
+template <typename Graph>
+tuning_report tune_label_parameters(Graph const& graph, tuning_options const& options = {}, label_parameters const& defaults = {});
+
+// writes a line for each candidate and the chosen parameters
+void print_tuning_report(tuning_report const& report, std::ostream& out = std::cout);
+
+// the parameters the engines use: parameters, or the tuned ones for graph if parameters.auto_tune_ is set
+template <typename Graph>
+label_parameters resolve_label_parameters(Graph const& graph, label_parameters const& parameters);
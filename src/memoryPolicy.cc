@@ -0,0 +1,243 @@
+#include "memoryPolicy.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t alignment = 64;
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+// from linux/mempolicy.h, mbind is called directly so libnuma is not needed
+constexpr int mpol_interleave = 3;
+constexpr unsigned mpol_mf_move = 1 << 1;
+
+// stored in the 64 bytes in front of each allocation, so it can be freed independent of the current policy
+struct allocation_header {
+    std::size_t size_;
+    bool mapped_;
+};
+static_assert(sizeof(allocation_header) <= alignment);
+
+// parses lists like "0-3,8" of /sys/devices/system/node
+std::vector<int> parse_list(std::string const& list) {
+    std::vector<int> values;
+    std::size_t position = 0;
+    while (position < list.size()) {
+        auto const end = std::min(list.find(',', position), list.size());
+        auto const range = list.substr(position, end - position);
+        auto const dash = range.find('-');
+        auto const first = std::stoi(range.substr(0, dash));
+        auto const last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (auto value = first; value <= last; ++value) values.push_back(value);
+        position = end + 1;
+    }
+    return values;
+}
+
+std::vector<int> read_list(std::string const& path) {
+    std::ifstream file(path);
+    std::string list;
+    if (!file || !std::getline(file, list) || list.empty()) return {};
+    return parse_list(list);
+}
+
+std::vector<int> const& numa_nodes() {
+    static auto const nodes = [] {
+        auto nodes = read_list("/sys/devices/system/node/online");
+        if (nodes.empty()) nodes.push_back(0);
+        return nodes;
+    }();
+    return nodes;
+}
+
+memory_policy& current_policy() {
+    static memory_policy policy = [] {
+        auto const* description = std::getenv("TR_MEMORY_POLICY");
+        return description == nullptr ? memory_policy{} : parse_memory_policy(description);
+    }();
+    return policy;
+}
+
+#ifdef __linux__
+void interleave_pages(void* memory, std::size_t const size, unsigned const flags) {
+    auto const& nodes = numa_nodes();
+    if (nodes.size() < 2) return;
+
+    unsigned long mask = 0;
+    for (auto const n : nodes) {
+        if (n < static_cast<int>(sizeof(mask) * 8)) mask |= 1ul << n;
+    }
+    // the policy is only a hint for the placement, so a failing mbind is ignored
+    syscall(SYS_mbind, memory, size, mpol_interleave, &mask, sizeof(mask) * 8 + 1, flags);
+}
+#endif
+
+} // namespace
+
+memory_policy parse_memory_policy(std::string_view description) {
+    memory_policy policy;
+    while (!description.empty()) {
+        auto const end = std::min(description.find(','), description.size());
+        auto const token = description.substr(0, end);
+        description.remove_prefix(std::min(end + 1, description.size()));
+
+        if (token == "standard") policy.pages_ = page_policy::standard;
+        else if (token == "thp") policy.pages_ = page_policy::transparent_huge_pages;
+        else if (token == "hugetlb") policy.pages_ = page_policy::explicit_huge_pages;
+        else if (token == "interleave") policy.numa_ = numa_policy::interleave;
+        else if (token == "first_touch") policy.numa_ = numa_policy::first_touch;
+        else if (token == "pin") policy.pin_threads_ = true;
+        else if (!token.empty()) throw std::invalid_argument("unknown memory policy " + std::string(token));
+    }
+    return policy;
+}
+
+memory_policy const& get_memory_policy() {
+    return current_policy();
+}
+
+void set_memory_policy(memory_policy const& policy) {
+    current_policy() = policy;
+}
+
+void* allocate_memory(std::size_t const size) {
+    auto const& policy = get_memory_policy();
+    std::byte* memory = nullptr;
+    allocation_header header{(size + 2 * alignment - 1) / alignment * alignment, false};
+
+#ifdef __linux__
+    if (policy.pages_ != page_policy::standard || policy.numa_ != numa_policy::none) {
+        // anonymous mappings are zeroed by the kernel without touching the pages, which keeps first touch placement intact
+        void* mapped = MAP_FAILED;
+        if (policy.pages_ == page_policy::explicit_huge_pages) {
+            auto const huge_size = (header.size_ + huge_page_size - 1) / huge_page_size * huge_page_size;
+            mapped = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mapped != MAP_FAILED) header.size_ = huge_size;
+        }
+        if (mapped == MAP_FAILED) {
+            mapped = mmap(nullptr, header.size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED) throw std::bad_alloc();
+            if (policy.pages_ != page_policy::standard) madvise(mapped, header.size_, MADV_HUGEPAGE);
+        }
+        if (policy.numa_ == numa_policy::interleave) interleave_pages(mapped, header.size_, 0);
+
+        memory = static_cast<std::byte*>(mapped);
+        header.mapped_ = true;
+    }
+#endif
+
+    if (memory == nullptr) {
+        memory = static_cast<std::byte*>(std::aligned_alloc(alignment, header.size_));
+        if (memory == nullptr) throw std::bad_alloc();
+        std::memset(memory, 0, header.size_);
+    }
+
+    std::memcpy(memory, &header, sizeof(header));
+    return memory + alignment;
+}
+
+void deallocate_memory(void* memory) {
+    if (memory == nullptr) return;
+    auto* begin = static_cast<std::byte*>(memory) - alignment;
+    allocation_header header;
+    std::memcpy(&header, begin, sizeof(header));
+
+#ifdef __linux__
+    if (header.mapped_) {
+        munmap(begin, header.size_);
+        return;
+    }
+#endif
+    std::free(begin);
+}
+
+void apply_memory_policy(void const* memory, std::size_t const size) {
+#ifdef __linux__
+    auto const& policy = get_memory_policy();
+    if (policy.pages_ == page_policy::standard && policy.numa_ != numa_policy::interleave) return;
+
+    // only whole pages inside the array can be advised
+    auto const page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto const begin = (reinterpret_cast<std::uintptr_t>(memory) + page_size - 1) / page_size * page_size;
+    auto const end = (reinterpret_cast<std::uintptr_t>(memory) + size) / page_size * page_size;
+    if (end <= begin) return;
+
+    auto* pages = reinterpret_cast<void*>(begin);
+    if (policy.pages_ != page_policy::standard) madvise(pages, end - begin, MADV_HUGEPAGE);
+    if (policy.numa_ == numa_policy::interleave) interleave_pages(pages, end - begin, mpol_mf_move);
+#endif
+}
+
+void apply_memory_policy(csr_graph const& graph) {
+    apply_memory_policy(graph.offsets_out_);
+    apply_memory_policy(graph.targets_out_);
+    apply_memory_policy(graph.offsets_in_);
+    apply_memory_policy(graph.targets_in_);
+}
+
+void apply_memory_policy(slab_graph const& graph) {
+    apply_memory_policy(graph.slab_);
+    apply_memory_policy(graph.twin_);
+    apply_memory_policy(graph.begin_);
+    apply_memory_policy(graph.middle_);
+}
+
+void apply_memory_policy(compressed_graph const& graph) {
+    apply_memory_policy(graph.bytes_out_);
+    apply_memory_policy(graph.offsets_out_);
+    apply_memory_policy(graph.bytes_in_);
+    apply_memory_policy(graph.offsets_in_);
+}
+
+bool pin_current_thread(std::size_t const worker) {
+#ifdef __linux__
+    if (!get_memory_policy().pin_threads_) return false;
+
+    auto const& nodes = numa_nodes();
+    auto const node = nodes[worker % nodes.size()];
+    auto cpus = read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (cpus.empty()) {
+        for (long cpu = 0; cpu < sysconf(_SC_NPROCESSORS_ONLN); ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpus[worker / nodes.size() % cpus.size()], &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    return false;
+#endif
+}
+
+scoped_thread_pin::scoped_thread_pin(std::size_t const worker) {
+#ifdef __linux__
+    static_assert(sizeof(previous_affinity_) == sizeof(cpu_set_t));
+    if (!get_memory_policy().pin_threads_) return;
+    // without the previous affinity it could not be restored, so the thread is not pinned then
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), reinterpret_cast<cpu_set_t*>(previous_affinity_.data())) != 0) return;
+    pinned_ = pin_current_thread(worker);
+#else
+    (void) worker;
+#endif
+}
+
+scoped_thread_pin::~scoped_thread_pin() {
+#ifdef __linux__
+    if (pinned_) pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), reinterpret_cast<cpu_set_t const*>(previous_affinity_.data()));
+#endif
+}
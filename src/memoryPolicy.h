@@ -0,0 +1,109 @@
+#pragma once
+#include "graphs.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+using namespace graphs;
+
+// how the pages of the big arrays (labels, adjacency storage, node orders) are backed
+enum class page_policy {
+    standard,               // the default pages of the allocator
+    transparent_huge_pages, // madvise(MADV_HUGEPAGE), the kernel uses huge pages where it can
+    explicit_huge_pages     // MAP_HUGETLB for the arrays allocated by allocate_memory, falls back to transparent huge pages
+};
+
+// how the pages are placed on the NUMA nodes
+enum class numa_policy {
+    none,        // the default policy of the process
+    interleave,  // the pages are spread round robin over all NUMA nodes
+    first_touch  // the arrays of allocate_memory are not written before they are used, so each page lands on the node of the thread that touches it first
+};
+
+struct memory_policy {
+    page_policy pages_ = page_policy::standard;
+    numa_policy numa_ = numa_policy::none;
+    bool pin_threads_ = false; // pin_current_thread pins the workers round robin to the NUMA nodes
+
+    bool operator==(memory_policy const&) const = default;
+};
+
+/**
+ * parses a comma separated list of the tokens standard, thp, hugetlb, interleave, first_touch and pin,
+ * e.g. "hugetlb,interleave,pin". throws std::invalid_argument for unknown tokens
+ */
+memory_policy parse_memory_policy(std::string_view description);
+
+// the policy used by all allocations, it is read from the environment variable TR_MEMORY_POLICY on first use,
+// so evaluation runs can be compared with and without it without recompiling. the labels follow it in
+// every engine, the graph arrays and the pinning only in the id based ones: tr_b and tr_o on csr_graph and tr_o_plus on
+// csr_graph, slab_graph and compressed_graph
+memory_policy const& get_memory_policy();
+
+void set_memory_policy(memory_policy const& policy);
+
+// returns 64 byte aligned and zeroed memory that is backed according to the current memory policy
+void* allocate_memory(std::size_t size);
+
+// frees memory of allocate_memory, also if the memory policy has changed in the meantime
+void deallocate_memory(void* memory);
+
+struct policy_deleter {
+    void operator()(void* memory) const {
+        deallocate_memory(memory);
+    }
+};
+
+// applies the page and NUMA policy to memory that was not allocated by allocate_memory (e.g. the data of a std::vector),
+// the pages that are already there are migrated if the policy is interleave
+void apply_memory_policy(void const* memory, std::size_t size);
+
+template <typename T>
+void apply_memory_policy(std::vector<T> const& array) {
+    apply_memory_policy(array.data(), array.size() * sizeof(T));
+}
+
+void apply_memory_policy(csr_graph const& graph);
+
+void apply_memory_policy(slab_graph const& graph);
+
+void apply_memory_policy(compressed_graph const& graph);
+
+// pins the calling thread to a cpu of the NUMA node worker % number of NUMA nodes if the policy pins threads,
+// returns whether the thread was pinned
+bool pin_current_thread(std::size_t worker);
+
+/**
+ * pins the calling thread with pin_current_thread(worker) for the lifetime of the object and restores the affinity the
+ * thread had before when it is destroyed. the TR engines pin the thread that calls them this way, so they do not change
+ * its affinity for the code that runs after them
+ */
+class scoped_thread_pin {
+public:
+    explicit scoped_thread_pin(std::size_t worker);
+
+    scoped_thread_pin(scoped_thread_pin const&) = delete;
+    scoped_thread_pin& operator=(scoped_thread_pin const&) = delete;
+
+    ~scoped_thread_pin();
+
+    bool pinned() const {
+        return pinned_;
+    }
+
+private:
+    bool pinned_ = false;
+    std::array<unsigned long, 16> previous_affinity_{}; // a cpu_set_t
+};
+
+// called by the TR engines before building the labels: applies the memory policy to the graph and its topological order
+template <typename Graph>
+void apply_memory_policy(Graph const& graph, std::vector<node_index> const& to) {
+    apply_memory_policy(graph);
+    apply_memory_policy(to);
+}
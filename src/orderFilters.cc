@@ -0,0 +1,46 @@
+#include "orderFilters.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
+
+template <typename Graph>
+order_filters build_order_filters(Graph const& g, std::vector<node_index> const& topological_order_reverse) {
+    auto const num_of_nodes = number_of_nodes(g);
+    if (static_cast<unsigned long long>(num_of_nodes) > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("the input graph has too many nodes for the order filters");
+    }
+
+    order_filters filters{std::vector<order_bounds>(num_of_nodes)};
+    auto& bounds = filters.bounds_;
+    for (long i = 0; i < num_of_nodes; ++i) {
+        auto const index = static_cast<std::uint32_t>(i);
+        bounds[topological_order_reverse[i]] = {index, 0, index, index};
+    }
+
+    // the predecessors of a node come before it in topological order and its successors after it
+    for (long i = 0; i < num_of_nodes; ++i) {
+        auto& n = bounds[topological_order_reverse[i]];
+        for (auto const m : predecessors(g, topological_order_reverse[i])) {
+            n.level_ = std::max(n.level_, bounds[m].level_ + 1);
+            n.min_reaching_ = std::min(n.min_reaching_, bounds[m].min_reaching_);
+        }
+    }
+    for (auto i = num_of_nodes - 1; i >= 0; --i) {
+        auto& n = bounds[topological_order_reverse[i]];
+        for (auto const m : successors(g, topological_order_reverse[i])) {
+            n.max_reachable_ = std::max(n.max_reachable_, bounds[m].max_reachable_);
+        }
+    }
+
+    return filters;
+}
+
+template order_filters build_order_filters(graph const&, std::vector<node_index> const&);
+template order_filters build_order_filters(csr_graph const&, std::vector<node_index> const&);
+template order_filters build_order_filters(slab_graph const&, std::vector<node_index> const&);
+template order_filters build_order_filters(compressed_graph const&, std::vector<node_index> const&);
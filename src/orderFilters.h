@@ -0,0 +1,45 @@
+#pragma once
+#include "graphs.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * the position of a node in a topological order together with the bounds derived from it, 16 bytes per node:
+ * level_ is the length of the longest path from a source to the node, max_reachable_ the largest topological index
+ * of a node reachable from it and min_reaching_ the smallest topological index of a node that reaches it
+ */
+struct order_bounds {
+    std::uint32_t topological_;
+    std::uint32_t level_;
+    std::uint32_t max_reachable_;
+    std::uint32_t min_reaching_;
+};
+
+// the filter that denied a query, none if the query needs to be searched
+enum class order_filter {
+    none,
+    topological, // topo(u) > topo(v)
+    level,       // level(u) >= level(v)
+    bounds       // max_reachable(u) < topo(v) or min_reaching(v) > topo(u)
+};
+
+// empty if no order filters were built
+struct order_filters {
+    std::vector<order_bounds> bounds_;
+};
+
+// topological_order_reverse is the node at each topological index, as returned by get_topological_order
+template <typename Graph>
+order_filters build_order_filters(Graph const& g, std::vector<node_index> const& topological_order_reverse);
+
+// the bounds of v should be loaded once per query, u == v is never denied
+inline order_filter check_order_filters(order_bounds const& u, order_bounds const& v) {
+    if (u.topological_ == v.topological_) return order_filter::none;
+    if (u.topological_ > v.topological_) return order_filter::topological;
+    if (u.level_ >= v.level_) return order_filter::level;
+    if (u.max_reachable_ < v.topological_ || v.min_reaching_ > u.topological_) return order_filter::bounds;
+    return order_filter::none;
+}
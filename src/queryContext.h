@@ -0,0 +1,89 @@
+#pragma once
+#include "graphs.h"
+#include "orderFilters.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace graphs;
+
+// how many queries each order filter denied before searching and how many queries were searched
+struct filter_counters {
+    long topological_ = 0;
+    long level_ = 0;
+    long bounds_ = 0;
+    long searched_ = 0;
+
+    void count(order_filter const filter) {
+        switch (filter) {
+            case order_filter::topological: ++topological_; break;
+            case order_filter::level: ++level_; break;
+            case order_filter::bounds: ++bounds_; break;
+            case order_filter::none: ++searched_; break;
+        }
+    }
+};
+
+/**
+ * the visited marks of reachability queries, one context can be reused by all queries of a thread.
+ * a node counts as visited if its stamp equals the epoch of the current query, so starting a query increments the epoch
+ * instead of clearing a mark for every node of the graph. the stack of the traversal is kept as well, so queries do not allocate.
+ * bidirectional queries mark the nodes of the backward search in backward_stamps_ and keep them on backward_stack_.
+ * frontier_ keeps the nodes a search over several targets has to check again for the next target
+ * and witnesses_ the witnesses of the redundancy check of an edge
+ */
+struct query_context {
+    std::vector<std::uint32_t> stamps_;
+    std::vector<std::uint32_t> backward_stamps_;
+    std::uint32_t epoch_ = 0;
+    std::vector<node_index> stack_;
+    std::vector<node_index> backward_stack_;
+    std::vector<node_index> frontier_;
+    std::vector<node_index> witnesses_;
+    filter_counters counters_;
+
+    query_context() = default;
+
+    explicit query_context(long const number_of_nodes) : stamps_(number_of_nodes, 0) {}
+
+    // starts a new query on a graph with number_of_nodes nodes, afterwards no node is visited
+    void begin_query(long const number_of_nodes) {
+        if (static_cast<long>(stamps_.size()) < number_of_nodes) stamps_.resize(number_of_nodes, 0);
+        if (++epoch_ == 0) { // the epoch wrapped around, so old stamps could be mistaken for the current epoch
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            std::fill(backward_stamps_.begin(), backward_stamps_.end(), 0);
+            epoch_ = 1;
+        }
+        stack_.clear();
+    }
+
+    // starts a new query that searches from both ends
+    void begin_bidirectional_query(long const number_of_nodes) {
+        if (static_cast<long>(backward_stamps_.size()) < number_of_nodes) backward_stamps_.resize(number_of_nodes, 0);
+        begin_query(number_of_nodes);
+        backward_stack_.clear();
+    }
+
+    bool is_visited(node_index const n) const {
+        return stamps_[n] == epoch_;
+    }
+
+    void visit(node_index const n) {
+        stamps_[n] = epoch_;
+    }
+
+    bool is_visited_backward(node_index const n) const {
+        return backward_stamps_[n] == epoch_;
+    }
+
+    void visit_backward(node_index const n) {
+        backward_stamps_[n] = epoch_;
+    }
+};
+
+// the context the query_reachability overloads without a context use, its counters_ sum up all queries of the thread
+inline query_context& thread_query_context() {
+    thread_local query_context context;
+    return context;
+}
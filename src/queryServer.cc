@@ -0,0 +1,199 @@
+#include "queryServer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+sockaddr_un socket_address(std::string const& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::system_error(ENAMETOOLONG, std::generic_category(), "the socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+// reads at least one byte unless the connection is closed, returns 0 then
+std::size_t read_some(int const socket, void* buffer, std::size_t const size) {
+    while (true) {
+        auto const read = ::read(socket, buffer, size);
+        if (read >= 0) return static_cast<std::size_t>(read);
+        if (errno != EINTR) return 0;
+    }
+}
+
+bool read_all(int const socket, void* buffer, std::size_t size) {
+    auto* bytes = static_cast<char*>(buffer);
+    while (size > 0) {
+        auto const read = read_some(socket, bytes, size);
+        if (read == 0) return false;
+        bytes += read;
+        size -= read;
+    }
+    return true;
+}
+
+bool write_all(int const socket, void const* buffer, std::size_t size) {
+    auto const* bytes = static_cast<char const*>(buffer);
+    while (size > 0) {
+        auto const written = ::send(socket, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+server_statistics summarize_latencies(std::vector<long>& latencies, std::size_t const batches, std::chrono::nanoseconds const elapsed) {
+    server_statistics statistics;
+    statistics.queries_ = latencies.size();
+    statistics.batches_ = batches;
+    if (latencies.empty()) return statistics;
+
+    auto const percentile = [&latencies](std::size_t const p) {
+        auto const rank = std::min(latencies.size() - 1, latencies.size() * p / 100);
+        std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+        return latencies[rank] / 1000.0;
+    };
+    statistics.p50_microseconds_ = percentile(50);
+    statistics.p99_microseconds_ = percentile(99);
+    if (elapsed.count() > 0) statistics.queries_per_second_ = latencies.size() * 1e9 / elapsed.count();
+    return statistics;
+}
+
+unix_socket_server::unix_socket_server(std::string path, query_handler handler, std::size_t const max_requests_per_read)
+    : path_(std::move(path)), handler_(std::move(handler)), max_requests_per_read_(std::max<std::size_t>(1, max_requests_per_read)) {
+    auto const address = socket_address(path_);
+    listener_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) throw std::system_error(errno, std::generic_category(), "socket");
+    ::unlink(path_.c_str());
+    if (::bind(listener_, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) < 0 || ::listen(listener_, SOMAXCONN) < 0) {
+        auto const error = errno;
+        ::close(listener_);
+        throw std::system_error(error, std::generic_category(), "cannot listen on " + path_);
+    }
+    acceptor_ = std::thread([this] { accept_connections(); });
+}
+
+unix_socket_server::~unix_socket_server() {
+    stop();
+}
+
+void unix_socket_server::stop() {
+    {
+        std::lock_guard lock(connections_mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+        // wakes the acceptor and the connections blocked in accept and read
+        ::shutdown(listener_, SHUT_RDWR);
+        for (auto& client : connections_) ::shutdown(client.socket_, SHUT_RDWR);
+    }
+    acceptor_.join();
+    ::close(listener_);
+    for (auto& client : connections_) {
+        client.thread_.join();
+        ::close(client.socket_);
+    }
+    connections_.clear();
+    ::unlink(path_.c_str());
+}
+
+void unix_socket_server::accept_connections() {
+    while (true) {
+        auto const socket = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+        auto const error = errno;
+        {
+            std::lock_guard lock(connections_mutex_);
+            if (stopping_) {
+                if (socket >= 0) ::close(socket);
+                return;
+            }
+            reap_finished_connections();
+            if (socket >= 0) {
+                auto& client = connections_.emplace_back();
+                client.socket_ = socket;
+                client.thread_ = std::thread([this, &client] { serve(client); });
+                continue;
+            }
+        }
+        if (error == EINTR || error == ECONNABORTED) continue;
+        // without a free file descriptor the connection stays in the backlog until a connection is closed
+        if (error == EMFILE || error == ENFILE) {
+            std::this_thread::sleep_for(accept_retry_delay);
+            continue;
+        }
+        return; // the listener is broken, the open connections are still served
+    }
+}
+
+void unix_socket_server::reap_finished_connections() {
+    for (auto client = connections_.begin(); client != connections_.end();) {
+        if (!client->finished_) {
+            ++client;
+            continue;
+        }
+        client->thread_.join();
+        ::close(client->socket_);
+        client = connections_.erase(client);
+    }
+}
+
+void unix_socket_server::serve(connection& client) {
+    // a read can end within a request, its first bytes are kept for the next read
+    std::vector<query_request> requests(max_requests_per_read_);
+    std::vector<std::uint8_t> answers(max_requests_per_read_);
+    std::size_t buffered = 0;
+    while (true) {
+        auto const read = read_some(client.socket_, reinterpret_cast<char*>(requests.data()) + buffered, requests.size() * sizeof(query_request) - buffered);
+        if (read == 0) break;
+        buffered += read;
+        auto const complete = buffered / sizeof(query_request);
+        if (complete == 0) continue;
+
+        handler_(std::span(requests).first(complete), std::span(answers).first(complete));
+        if (!write_all(client.socket_, answers.data(), complete)) break;
+        buffered -= complete * sizeof(query_request);
+        std::memmove(requests.data(), requests.data() + complete, buffered);
+    }
+    client.finished_ = true;
+}
+
+query_client::query_client(std::string const& path) {
+    auto const address = socket_address(path);
+    socket_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_ < 0) throw std::system_error(errno, std::generic_category(), "socket");
+    if (::connect(socket_, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) < 0) {
+        auto const error = errno;
+        ::close(socket_);
+        throw std::system_error(error, std::generic_category(), "cannot connect to " + path);
+    }
+}
+
+query_client::query_client(query_client&& other) noexcept : socket_(other.socket_) {
+    other.socket_ = -1;
+}
+
+query_client::~query_client() {
+    if (socket_ >= 0) ::close(socket_);
+}
+
+std::vector<std::uint8_t> query_client::query(std::span<query_request const> const requests) {
+    std::vector<std::uint8_t> answers(requests.size());
+    for (std::size_t first = 0; first < requests.size(); first += client_chunk_size) {
+        auto const size = std::min(client_chunk_size, requests.size() - first);
+        if (!write_all(socket_, requests.data() + first, size * sizeof(query_request)) || !read_all(socket_, answers.data() + first, size)) {
+            throw std::system_error(ECONNRESET, std::generic_category(), "the connection to the query server was lost");
+        }
+    }
+    return answers;
+}
@@ -0,0 +1,361 @@
+#pragma once
+#include "graphs.h"
+#include "BFL.h"
+#include "batchQueries.h"
+#include "memoryPolicy.h"
+#include "queryContext.h"
+#include "redundancyIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace graphs;
+
+enum class query_kind : std::uint32_t {
+    reachability, // whether u reaches v
+    redundancy    // whether the edge (u, v) is redundant, i.e. u reaches v without it
+};
+
+// a request as it is sent over the socket, the answer to it is one byte
+struct query_request {
+    query_kind kind_;
+    std::uint32_t reserved_ = 0;
+    std::int64_t u_;
+    std::int64_t v_;
+};
+static_assert(sizeof(query_request) == 24);
+
+// the answer to a request with an unknown kind or a node that is not in the graph, the other answers are 0 and 1
+inline constexpr std::uint8_t invalid_query_answer = 2;
+
+/**
+ * number_of_threads_ is the number of workers that answer the batches (0 means one per core). a worker takes up to
+ * max_batch_size_ pending requests at once, but waits for more as long as the oldest of them is younger than max_batch_delay_
+ */
+struct server_options {
+    std::size_t number_of_threads_ = 0;
+    std::size_t max_batch_size_ = 256;
+    std::chrono::microseconds max_batch_delay_{50};
+};
+
+// the latencies are from submitting a request until its batch is answered, the throughput is over the time from the
+// first request to the last answer
+struct server_statistics {
+    std::size_t queries_ = 0;
+    std::size_t batches_ = 0;
+    double p50_microseconds_ = 0;
+    double p99_microseconds_ = 0;
+    double queries_per_second_ = 0;
+};
+
+// sorts the latencies in nanoseconds to take the percentiles
+server_statistics summarize_latencies(std::vector<long>& latencies, std::size_t batches, std::chrono::nanoseconds elapsed);
+
+/**
+ * coalesces the requests of any number of threads into batches that a pool of workers answers against a shared
+ * redundancy_index, whose labels answer the reachability requests. each worker keeps its own query_context and answers
+ * the reachability requests of a batch as query_reachability_batch does: first by their labels, prefetched a few requests
+ * ahead, and then the remaining ones by a search. the index is only read, so it must outlive the batcher
+ */
+template <typename Index>
+class query_batcher {
+public:
+    query_batcher(Index const& index, server_options const& options = {}) : index_(index), options_(options) {
+        options_.max_batch_size_ = std::max<std::size_t>(1, options_.max_batch_size_);
+        auto const number_of_threads = options_.number_of_threads_ == 0 ? std::max(1u, std::thread::hardware_concurrency()) : options_.number_of_threads_;
+        workers_.reserve(number_of_threads);
+        for (std::size_t worker = 0; worker < number_of_threads; ++worker) {
+            workers_.emplace_back([this, worker] { work(worker); });
+        }
+    }
+
+    query_batcher(query_batcher const&) = delete;
+    query_batcher& operator=(query_batcher const&) = delete;
+
+    ~query_batcher() {
+        stop();
+    }
+
+    // answers the requests that are still pending, then stops the workers
+    void stop() {
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        available_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    // blocks until all requests are answered, the requests of one call can be answered in different batches
+    void answer(std::span<query_request const> const requests, std::span<std::uint8_t> const answers) {
+        if (requests.empty()) return;
+        submission submitted{answers, requests.size()};
+        auto const arrival = std::chrono::steady_clock::now();
+        {
+            std::lock_guard lock(statistics_mutex_);
+            if (first_arrival_ == std::chrono::steady_clock::time_point{}) first_arrival_ = arrival;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            for (std::size_t i = 0; i < requests.size(); ++i) pending_.push_back({requests[i], arrival, &submitted, i});
+        }
+        if (requests.size() >= options_.max_batch_size_) available_.notify_all();
+        else available_.notify_one();
+
+        std::unique_lock lock(submitted.mutex_);
+        submitted.answered_.wait(lock, [&submitted] { return submitted.done_; });
+    }
+
+    std::vector<std::uint8_t> answer(std::span<query_request const> const requests) {
+        std::vector<std::uint8_t> answers(requests.size());
+        answer(requests, answers);
+        return answers;
+    }
+
+    server_statistics statistics() const {
+        std::lock_guard lock(statistics_mutex_);
+        auto latencies = latencies_;
+        return summarize_latencies(latencies, batches_, last_answer_ - first_arrival_);
+    }
+
+    void reset_statistics() {
+        std::lock_guard lock(statistics_mutex_);
+        latencies_.clear();
+        batches_ = 0;
+        first_arrival_ = {};
+        last_answer_ = {};
+    }
+
+private:
+    // the requests of one call of answer, the last worker that answers one of them wakes the caller
+    struct submission {
+        std::span<std::uint8_t> answers_;
+        std::atomic<std::size_t> remaining_;
+        std::mutex mutex_;
+        std::condition_variable answered_;
+        bool done_ = false;
+
+        submission(std::span<std::uint8_t> const answers, std::size_t const remaining) : answers_(answers), remaining_(remaining) {}
+    };
+
+    struct pending_request {
+        query_request request_;
+        std::chrono::steady_clock::time_point arrival_;
+        submission* submission_;
+        std::size_t position_;
+    };
+
+    void work(std::size_t const worker) {
+        pin_current_thread(worker);
+        auto context = index_.make_query_context();
+        std::vector<pending_request> batch;
+        std::vector<std::size_t> unknown;
+        std::vector<long> latencies;
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                available_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+                if (pending_.empty()) return;
+                // the batch is taken once it is full or its oldest request has waited long enough
+                auto const deadline = pending_.front().arrival_ + options_.max_batch_delay_;
+                available_.wait_until(lock, deadline, [this] { return stopping_ || pending_.size() >= options_.max_batch_size_; });
+                if (pending_.empty()) continue; // another worker took them
+                auto const size = std::min(pending_.size(), options_.max_batch_size_);
+                batch.assign(pending_.begin(), pending_.begin() + size);
+                pending_.erase(pending_.begin(), pending_.begin() + size);
+                if (!pending_.empty()) available_.notify_one();
+            }
+            answer_batch(batch, unknown, context);
+
+            auto const now = std::chrono::steady_clock::now();
+            latencies.clear();
+            for (auto const& pending : batch) latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - pending.arrival_).count());
+            {
+                std::lock_guard lock(statistics_mutex_);
+                latencies_.insert(latencies_.end(), latencies.begin(), latencies.end());
+                ++batches_;
+                last_answer_ = std::max(last_answer_, now);
+            }
+            for (auto const& pending : batch) {
+                if (pending.submission_->remaining_.fetch_sub(1) != 1) continue;
+                // notified under the lock, so the caller cannot return and destroy the submission before
+                std::lock_guard lock(pending.submission_->mutex_);
+                pending.submission_->done_ = true;
+                pending.submission_->answered_.notify_one();
+            }
+        }
+    }
+
+    void answer_batch(std::vector<pending_request> const& batch, std::vector<std::size_t>& unknown, query_context& context) const {
+        auto const& labeled_graph = index_.labeled_graph_;
+        auto const num_of_nodes = index_.number_of_nodes();
+        auto const is_node = [num_of_nodes](std::int64_t const n) { return n >= 0 && n < num_of_nodes; };
+
+        // the labels decide most reachability requests, so they are checked for all of them before any search
+        unknown.clear();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (i + query_prefetch_distance < batch.size()) {
+                auto const& ahead = batch[i + query_prefetch_distance].request_;
+                if (ahead.kind_ == query_kind::reachability && is_node(ahead.u_) && is_node(ahead.v_)) {
+                    prefetch_labels(labeled_graph, ahead.u_);
+                    prefetch_labels(labeled_graph, ahead.v_);
+                }
+            }
+            auto const& [kind, reserved, u, v] = batch[i].request_;
+            auto& answer = batch[i].submission_->answers_[batch[i].position_];
+            if (!is_node(u) || !is_node(v) || (kind != query_kind::reachability && kind != query_kind::redundancy)) {
+                answer = invalid_query_answer;
+            } else if (kind == query_kind::redundancy) {
+                answer = index_.is_redundant(u, v, context);
+            } else if (auto const decided = check_labels(labeled_graph, u, v); decided != label_answer::unknown) {
+                answer = decided == label_answer::reachable;
+            } else {
+                unknown.push_back(i);
+            }
+        }
+        for (auto const i : unknown) {
+            auto const& request = batch[i].request_;
+            batch[i].submission_->answers_[batch[i].position_] = query_reachability(labeled_graph, request.u_, request.v_, context);
+        }
+    }
+
+    Index const& index_;
+    server_options options_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<pending_request> pending_;
+    bool stopping_ = false;
+
+    mutable std::mutex statistics_mutex_;
+    std::vector<long> latencies_;
+    std::size_t batches_ = 0;
+    std::chrono::steady_clock::time_point first_arrival_;
+    std::chrono::steady_clock::time_point last_answer_;
+};
+
+// answers the requests of one read of a connection
+using query_handler = std::function<void(std::span<query_request const>, std::span<std::uint8_t>)>;
+
+/**
+ * accepts connections on a Unix domain socket at path, each on its own thread. a client sends any number of query_request
+ * and receives one answer byte per request in the same order, the requests of one read are handed to the handler together.
+ * an existing socket file at path is replaced, it is removed again by stop. throws std::system_error if it cannot listen.
+ * if the process runs out of file descriptors, accepting is retried every accept_retry_delay, after any other error of
+ * accept except an interrupt or an aborted connection no more connections are accepted
+ */
+class unix_socket_server {
+public:
+    unix_socket_server(std::string path, query_handler handler, std::size_t max_requests_per_read = 256);
+
+    unix_socket_server(unix_socket_server const&) = delete;
+    unix_socket_server& operator=(unix_socket_server const&) = delete;
+
+    ~unix_socket_server();
+
+    // closes the socket and all connections, returns once their threads have finished
+    void stop();
+
+    std::string const& path() const {
+        return path_;
+    }
+
+    static constexpr std::chrono::milliseconds accept_retry_delay{10};
+
+private:
+    struct connection {
+        int socket_;
+        std::thread thread_;
+        std::atomic<bool> finished_{false};
+    };
+
+    void accept_connections();
+
+    // joins the threads of the closed connections, called with connections_mutex_ held
+    void reap_finished_connections();
+
+    void serve(connection& client);
+
+    std::string path_;
+    query_handler handler_;
+    std::size_t max_requests_per_read_;
+    int listener_;
+    std::thread acceptor_;
+
+    std::mutex connections_mutex_;
+    std::list<connection> connections_;
+    bool stopping_ = false;
+};
+
+/**
+ * a local query service over a built index: the requests of all connections of a unix_socket_server are coalesced into
+ * batches by a query_batcher. in-process callers can skip the socket with answer
+ */
+template <typename Index>
+class query_server {
+public:
+    query_server(Index const& index, std::string path, server_options const& options = {})
+        : batcher_(index, options),
+          socket_(std::move(path), [this](std::span<query_request const> const requests, std::span<std::uint8_t> const answers) { batcher_.answer(requests, answers); },
+                  options.max_batch_size_) {}
+
+    void stop() {
+        socket_.stop();
+        batcher_.stop();
+    }
+
+    std::vector<std::uint8_t> answer(std::span<query_request const> const requests) {
+        return batcher_.answer(requests);
+    }
+
+    server_statistics statistics() const {
+        return batcher_.statistics();
+    }
+
+    void reset_statistics() {
+        batcher_.reset_statistics();
+    }
+
+    std::string const& path() const {
+        return socket_.path();
+    }
+
+private:
+    query_batcher<Index> batcher_; // destroyed after the socket, whose connections still hand requests to it
+    unix_socket_server socket_;
+};
+
+// a connection to a unix_socket_server, one client must not be used by several threads at once
+class query_client {
+public:
+    explicit query_client(std::string const& path);
+
+    query_client(query_client&& other) noexcept;
+    query_client(query_client const&) = delete;
+    query_client& operator=(query_client const&) = delete;
+
+    ~query_client();
+
+    // sends the requests in chunks of client_chunk_size and reads the answers of each chunk before the next one is sent,
+    // so neither side blocks on a full socket buffer. throws std::system_error if the connection is lost
+    std::vector<std::uint8_t> query(std::span<query_request const> requests);
+
+    static constexpr std::size_t client_chunk_size = 4096;
+
+private:
+    int socket_;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include "graphs.h"
+#include "BFL.h"
+#include "batchQueries.h"
+#include "queryContext.h"
+
+#include <utility>
+
+using namespace graphs;
+
+/**
+ * a long lived reachability index over a labeled graph (labeled_graph or budgeted_labeled_graph).
+ * the index itself is only read by the queries, so it can be shared by several threads as long as each thread
+ * queries with its own context of make_query_context
+ */
+template <typename LabeledGraph>
+struct reachability_index {
+    LabeledGraph labeled_graph_;
+
+    explicit reachability_index(LabeledGraph&& labeled_graph) : labeled_graph_(std::move(labeled_graph)) {}
+
+    long number_of_nodes() const {
+        return graphs::number_of_nodes(labeled_graph_.graph_);
+    }
+
+    query_context make_query_context() const {
+        return query_context(number_of_nodes());
+    }
+
+    // the work of a query depends on the nodes visited by it, not on the size of the graph
+    bool reachable(node_index const u, node_index const v, query_context& context) const {
+        return query_reachability(labeled_graph_, u, v, context);
+    }
+
+    // answers a batch of queries on number_of_threads threads, see query_reachability_batch
+    reachability_bitmap reachable(std::span<reachability_query const> const queries, std::size_t const number_of_threads = 0) const {
+        return query_reachability_batch(labeled_graph_, queries, number_of_threads);
+    }
+};
+
+template <size_t hash_range, typename Graph, bucket_source Buckets>
+reachability_index<labeled_graph<hash_range, Graph>> build_reachability_index(Graph const& graph, Buckets const& policy, long const d, long const number_of_interval_labelings = 0) {
+    return reachability_index<labeled_graph<hash_range, Graph>>(build_labeled_graph<hash_range>(graph, policy, d, number_of_interval_labelings));
+}
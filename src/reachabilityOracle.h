@@ -0,0 +1,121 @@
+#pragma once
+#include "graphs.h"
+#include "BFL.h"
+#include "dagUtil.h"
+#include "labelArena.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * what the TR engines need of a reachability index: the graph it was built for as graph_ and
+ * query_reachability(oracle, u, v), which returns whether u reaches v and may be called by several threads at once.
+ * labeled_graph (BFL) and budgeted_labeled_graph satisfy it, as do the oracles below, so the engines are instantiated
+ * for each oracle without any virtual calls
+ */
+template <typename Oracle>
+concept reachability_oracle = requires(Oracle const& oracle, node_index const u, node_index const v) {
+    oracle.graph_;
+    { query_reachability(oracle, u, v) } -> std::convertible_to<bool>;
+};
+
+// an oracle with BFL style labels, check_labels(oracle, n, v) and prefetch_labels(oracle, n) can prune a search of the caller
+template <typename Oracle>
+concept labeled_reachability_oracle = reachability_oracle<Oracle> && requires(Oracle const& oracle, node_index const n) {
+    { check_labels(oracle, n, n) } -> std::same_as<label_answer>;
+    prefetch_labels(oracle, n);
+};
+
+// queries the oracle in the given direction if it supports a search direction, otherwise as it is
+template <reachability_oracle Oracle>
+bool query_oracle(Oracle const& oracle, node_index const u, node_index const v, search_direction const direction) {
+    if constexpr (requires { query_reachability(oracle, u, v, direction); }) {
+        return query_reachability(oracle, u, v, direction);
+    } else {
+        return query_reachability(oracle, u, v);
+    }
+}
+
+/**
+ * the exact transitive closure as one bitset of n bits per node, so each query is a single bit test.
+ * it needs n^2 / 8 bytes and is only meant for small graphs
+ */
+template <typename Graph>
+struct closure_oracle {
+    static constexpr long max_number_of_nodes = 1 << 16;
+
+    Graph const& graph_;
+    std::size_t words_per_node_;
+    std::vector<std::uint64_t> closure_;
+
+    explicit closure_oracle(Graph const& graph) : graph_(graph), words_per_node_((number_of_nodes(graph) + 63) / 64) {
+        auto const num_of_nodes = number_of_nodes(graph);
+        if (num_of_nodes > max_number_of_nodes) {
+            throw std::invalid_argument("the graph has too many nodes for a transitive closure");
+        }
+        closure_.assign(num_of_nodes * words_per_node_, 0);
+
+        // in reverse topological order the successors of a node are done before the node
+        auto const [to, to_reverse] = get_topological_order(graph);
+        for (auto i = num_of_nodes - 1; i >= 0; --i) {
+            auto const n = to_reverse[i];
+            auto* row = closure_.data() + n * words_per_node_;
+            row[n / 64] |= std::uint64_t{1} << (n % 64);
+            for (auto const m : successors(graph, n)) {
+                auto const* successor_row = closure_.data() + m * words_per_node_;
+                for (std::size_t w = 0; w < words_per_node_; ++w) row[w] |= successor_row[w];
+            }
+        }
+    }
+};
+
+template <typename Graph>
+bool query_reachability(closure_oracle<Graph> const& oracle, node_index const u, node_index const v) {
+    return (oracle.closure_[u * oracle.words_per_node_ + v / 64] >> (v % 64)) & 1;
+}
+
+// only the DFS intervals of BFL, they confirm reachability along the DFS tree and everything else is searched
+template <typename Graph>
+struct interval_oracle {
+    Graph const& graph_;
+    std::vector<interval> intervals_;
+
+    explicit interval_oracle(Graph const& graph) : graph_(graph), intervals_(number_of_nodes(graph), interval{0, 0}) {
+        depth_first_search(graph, intervals_.data());
+    }
+};
+
+template <typename Graph>
+bool query_reachability(interval_oracle<Graph> const& oracle, node_index const u, node_index const v) {
+    auto& context = thread_query_context();
+    context.begin_query(number_of_nodes(oracle.graph_));
+    auto const& intervals = oracle.intervals_;
+    return search_reachability(oracle.graph_, u, context,
+        [&intervals, v](node_index const n) {
+            return intervals[n].discovery_ <= intervals[v].discovery_ && intervals[v].finish_ <= intervals[n].finish_ ? label_answer::reachable : label_answer::unknown;
+        },
+        [&intervals](node_index const n) { __builtin_prefetch(intervals.data() + n); });
+}
+
+// no index at all, each query is a plain DFS from u
+template <typename Graph>
+struct dfs_oracle {
+    Graph const& graph_;
+
+    explicit dfs_oracle(Graph const& graph) : graph_(graph) {}
+};
+
+template <typename Graph>
+bool query_reachability(dfs_oracle<Graph> const& oracle, node_index const u, node_index const v) {
+    auto& context = thread_query_context();
+    context.begin_query(number_of_nodes(oracle.graph_));
+    return search_reachability(oracle.graph_, u, context,
+        [v](node_index const n) { return n == v ? label_answer::reachable : label_answer::unknown; },
+        [](node_index) {});
+}
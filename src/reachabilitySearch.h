@@ -0,0 +1,125 @@
+#pragma once
+#include "graphs.h"
+#include "queryContext.h"
+
+#include <algorithm>
+
+using namespace graphs;
+
+// what the labels of a node n tell about whether n reaches the target of a query
+enum class label_answer {
+    reachable,   // confirmed by the DFS intervals
+    unreachable, // denied by label_in or label_out
+    unknown      // the successors of n need to be searched
+};
+
+// how a reachability query searches between u and v. bidirectional queries were faster than forward ones on all
+// evaluated graphs, because the targets of the queries of tr_o_plus often have few incoming edges
+enum class search_direction {
+    forward,       // from u along the outgoing edges
+    bidirectional, // from u along the outgoing edges and from v along the incoming edges until the searches meet
+    automatic      // bidirectional if v has fewer incoming than u outgoing edges, forward otherwise
+};
+
+// replaces automatic by the direction that is used for the query from u to v
+template <typename Graph>
+search_direction resolve_search_direction(Graph const& graph, node_index const u, node_index const v, search_direction const direction) {
+    if (direction != search_direction::automatic) return direction;
+    return in_degree(graph, v) < out_degree(graph, u) ? search_direction::bidirectional : search_direction::forward;
+}
+
+/**
+ * the traversal of a reachability search from the nodes on context.stack_, which the caller has marked, the top of the
+ * stack is checked first. neighbors(n) is the range of nodes the search follows from n, e.g. the successors of n.
+ * check(n) returns the label_answer of node n, prefetch(n) prefetches the labels check(n) reads.
+ * the labels of the neighbors of a node are prefetched when they are pushed and checked when they are popped, in the
+ * order of the edges as in a recursive search. nodes are marked when they are pushed, so each node is checked at most once
+ */
+template <typename Neighbors, typename Check, typename Prefetch>
+bool search_from_stack(query_context& context, Neighbors const& neighbors, Check const& check, Prefetch const& prefetch) {
+    auto& stack = context.stack_;
+    while (!stack.empty()) {
+        auto const n = stack.back();
+        stack.pop_back();
+
+        auto const answer = check(n);
+        if (answer == label_answer::reachable) return true;
+        if (answer == label_answer::unreachable) continue;
+
+        auto const first_pushed = stack.size();
+        for (auto const w : neighbors(n)) {
+            if (context.is_visited(w)) continue;
+            context.visit(w);
+            prefetch(w);
+            stack.push_back(w);
+        }
+        // the first neighbor has to be on top of the stack
+        std::reverse(stack.begin() + first_pushed, stack.end());
+    }
+    return false;
+}
+
+// the traversal of a reachability query from u with an explicit stack, so deep DAGs neither pay a call per hop nor overflow the call stack
+template <typename Graph, typename Check, typename Prefetch>
+bool search_reachability(Graph const& graph, node_index const u, query_context& context, Check const& check, Prefetch const& prefetch) {
+    context.visit(u);
+    context.stack_.push_back(u);
+    return search_from_stack(context, [&graph](node_index const n) { return successors(graph, n); }, check, prefetch);
+}
+
+/**
+ * searches forward from u and backward from v, each node is marked by the side that reaches it first. check_forward(n)
+ * is the label_answer of n for reaching v, check_backward(n) the one of u for reaching n, so both sides prune with the labels.
+ * each step pops the top of the side whose node has the smaller degree in its direction. if one side pushes a node the other
+ * side has marked, u reaches it and it reaches v. a side that runs empty has searched everything, so the answer is false
+ */
+template <typename Graph, typename CheckForward, typename CheckBackward, typename Prefetch>
+bool search_reachability_bidirectional(Graph const& graph, node_index const u, node_index const v, query_context& context,
+                                       CheckForward const& check_forward, CheckBackward const& check_backward, Prefetch const& prefetch) {
+    if (u == v) return true;
+    auto& forward = context.stack_;
+    auto& backward = context.backward_stack_;
+    context.visit(u);
+    forward.push_back(u);
+    context.visit_backward(v);
+    backward.push_back(v);
+
+    while (!forward.empty() && !backward.empty()) {
+        if (out_degree(graph, forward.back()) <= in_degree(graph, backward.back())) {
+            auto const n = forward.back();
+            forward.pop_back();
+
+            auto const answer = check_forward(n);
+            if (answer == label_answer::reachable) return true;
+            if (answer == label_answer::unreachable) continue;
+
+            auto const first_pushed = forward.size();
+            for (auto const w : successors(graph, n)) {
+                if (context.is_visited_backward(w)) return true;
+                if (context.is_visited(w)) continue;
+                context.visit(w);
+                prefetch(w);
+                forward.push_back(w);
+            }
+            std::reverse(forward.begin() + first_pushed, forward.end());
+        } else {
+            auto const n = backward.back();
+            backward.pop_back();
+
+            auto const answer = check_backward(n);
+            if (answer == label_answer::reachable) return true;
+            if (answer == label_answer::unreachable) continue;
+
+            auto const first_pushed = backward.size();
+            for (auto const w : predecessors(graph, n)) {
+                if (context.is_visited(w)) return true;
+                if (context.is_visited_backward(w)) continue;
+                context.visit_backward(w);
+                prefetch(w);
+                backward.push_back(w);
+            }
+            std::reverse(backward.begin() + first_pushed, backward.end());
+        }
+    }
+    return false;
+}
@@ -0,0 +1,213 @@
+#pragma once
+#include "graphs.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+using namespace graphs;
+
+// how TR-O-Plus decides whether an edge (u, v) is redundant. on the evaluated graphs per_source was up to 6 times faster
+// than per_witness on dense graphs, only on amaze it was slower because of its high out-degrees
+enum class redundancy_check {
+    per_witness, // one reachability query per witness w, each with its own visited marks
+    per_edge,    // one search from all witnesses of the edge at once, so the witnesses share the visited marks
+    per_source   // one search per node u that answers all outgoing edges of u, the marks are shared by all of them
+};
+
+// how many witnesses ahead filter_witnesses prefetches the labels
+inline constexpr std::size_t witness_prefetch_distance = 8;
+
+/**
+ * collects the witnesses of the edge (u, v) into context.witnesses_ and returns whether they are predecessors of v: the
+ * predecessors w of v after u in the topological order if v has fewer incoming edges than u outgoing ones, otherwise the
+ * successors w of u before v. the edges of graph need to be in topological order
+ */
+template <typename Graph>
+bool collect_witnesses(Graph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to, query_context& context) {
+    auto& witnesses = context.witnesses_;
+    witnesses.clear();
+    if(out_degree(graph, u) > in_degree(graph, v)) {
+        for (auto const w : predecessors(graph, v)) { // loop in descending order through incoming_edges
+            if (to[w] <= to[u]) break;
+            witnesses.push_back(w);
+        }
+        return true;
+    }
+    for (auto const w : successors(graph, u)) { // loop in ascending order through outgoing_edges
+        if (to[w] >= to[v]) break;
+        witnesses.push_back(w);
+    }
+    return false;
+}
+
+/**
+ * the first stage of a redundancy check, it decides the witnesses in context.witnesses_ by their labels only. check(w) is
+ * the label_answer of witness w, the labels are prefetched a few witnesses ahead, so the subset tests of consecutive
+ * witnesses do not wait for each other's cache misses. returns true as soon as the labels of a witness confirm the edge,
+ * that witness is left as the only one. otherwise only the witnesses the labels did not decide are left, ordered by
+ * likelihood(w) from high to low
+ */
+template <typename LabeledGraph, typename Check, typename Likelihood>
+bool filter_witnesses(LabeledGraph const& graph, query_context& context, Check const& check, Likelihood const& likelihood) {
+    auto& witnesses = context.witnesses_;
+    for (std::size_t i = 0; i < std::min(witness_prefetch_distance, witnesses.size()); ++i) prefetch_labels(graph, witnesses[i]);
+    std::size_t undecided = 0;
+    for (std::size_t i = 0; i < witnesses.size(); ++i) {
+        if (i + witness_prefetch_distance < witnesses.size()) prefetch_labels(graph, witnesses[i + witness_prefetch_distance]);
+        auto const answer = check(witnesses[i]);
+        if (answer == label_answer::reachable) {
+            witnesses.assign(1, witnesses[i]);
+            return true;
+        }
+        if (answer == label_answer::unknown) witnesses[undecided++] = witnesses[i];
+    }
+    witnesses.resize(undecided);
+    if (undecided > 1) {
+        std::sort(witnesses.begin(), witnesses.end(), [&likelihood](node_index const a, node_index const b) { return likelihood(a) > likelihood(b); });
+    }
+    return false;
+}
+
+/**
+ * collects and filters the witnesses of (u, v), returns true if their labels confirm the edge redundant and otherwise
+ * whether the undecided witnesses left in context.witnesses_ are predecessors of v.
+ * a successor w of u is more likely to reach v the more nodes are below it in the DFS tree, a predecessor w of v is more
+ * likely to be reached by u the more incoming edges it has
+ */
+template <typename LabeledGraph>
+std::tuple<bool, bool> prefilter_witnesses(LabeledGraph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to, query_context& context) {
+    auto const& g = graph.graph_;
+    if (collect_witnesses(g, u, v, to, context)) {
+        return {filter_witnesses(graph, context, [&graph, u](node_index const w) { return check_labels(graph, u, w); },
+                                 [&g](node_index const w) { return in_degree(g, w); }), true};
+    }
+    return {filter_witnesses(graph, context, [&graph, v](node_index const w) { return check_labels(graph, w, v); },
+                             [&graph](node_index const w) { return dfs_interval(graph, w).finish_ - dfs_interval(graph, w).discovery_; }), false};
+}
+
+/**
+ * returns a witness that proves the edge (u, v) redundant or nothing if it is not redundant, checked in two stages:
+ * the labels of all witnesses are checked by prefilter_witnesses before any of them is searched, then the undecided
+ * witnesses are queried one by one in the given direction, the most likely first. a witness whose labels rule it out never
+ * starts a search, which matters for the nodes with many witnesses.
+ * LabeledGraph is a labeled_graph or a budgeted_labeled_graph of a graph with its edges in topological order
+ */
+template <typename LabeledGraph>
+std::optional<node_index> find_witness(LabeledGraph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to,
+                                       query_context& context, search_direction const direction) {
+    auto const [confirmed, backward] = prefilter_witnesses(graph, u, v, to, context);
+    if (confirmed) return context.witnesses_.front();
+    for (auto const w : context.witnesses_) {
+        if (backward ? query_reachability(graph, u, w, context, direction) : query_reachability(graph, w, v, context, direction)) return w;
+    }
+    return std::nullopt;
+}
+
+// whether the edge (u, v) is redundant, see find_witness
+template <typename LabeledGraph>
+bool is_redundant_filtered(LabeledGraph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to, search_direction const direction) {
+    return find_witness(graph, u, v, to, thread_query_context(), direction).has_value();
+}
+
+/**
+ * whether the edge (u, v) is redundant, decided by one search from all its witnesses: the successors w of u before v in
+ * the topological order are searched forward at once with check_labels(graph, n, v), or if v has fewer incoming edges
+ * than u outgoing ones, the predecessors w of v after u are searched backward at once with check_labels(graph, u, n).
+ * a node reached from one witness is not searched again from the next, which the queries of is_redundant_tro_plus do.
+ * the witnesses are filtered by prefilter_witnesses first, the most likely undecided witness is searched first.
+ * LabeledGraph is a labeled_graph or a budgeted_labeled_graph of a graph with its edges in topological order
+ */
+template <typename LabeledGraph>
+bool is_redundant_shared(LabeledGraph const& graph, node_index const u, node_index const v, std::vector<node_index> const& to, query_context& context) {
+    auto const [confirmed, backward] = prefilter_witnesses(graph, u, v, to, context);
+    if (confirmed) return true;
+
+    auto const& g = graph.graph_;
+    auto& stack = context.stack_;
+    context.begin_query(number_of_nodes(g));
+    // the most likely witness has to be on top of the stack
+    for (auto it = context.witnesses_.rbegin(); it != context.witnesses_.rend(); ++it) {
+        context.visit(*it);
+        stack.push_back(*it);
+    }
+    auto const prefetch = [&graph](node_index const n) { prefetch_labels(graph, n); };
+    if (backward) {
+        return search_from_stack(context, [&g](node_index const n) { return predecessors(g, n); },
+            [&graph, u](node_index const n) { return check_labels(graph, u, n); }, prefetch);
+    }
+    return search_from_stack(context, [&g](node_index const n) { return successors(g, n); },
+        [&graph, v](node_index const n) { return check_labels(graph, n, v); }, prefetch);
+}
+
+/**
+ * finds the redundant outgoing edges of u with one search that is continued for each of them. the successors v_1, v_2, ...
+ * of u are handled in topological order, the witnesses of (u, v_j) are v_1, ..., v_(j-1).
+ * all nodes the search marked are reached from a witness, so (u, v_j) is redundant if v_j is marked. otherwise only the
+ * nodes of context.frontier_ are checked with the labels of v_j: the nodes the labels denied for an earlier successor and
+ * the nodes still on the stack when an earlier search stopped. every other marked node was expanded, so its successors are
+ * marked as well and a path from a witness to v_j leaves the marked nodes through the frontier.
+ * redundant(i, v_i) is called for the i-th outgoing edge (u, v_i) of u if it is redundant, in ascending order of i.
+ * LabeledGraph is a labeled_graph or a budgeted_labeled_graph of a graph with its edges in topological order
+ */
+template <typename LabeledGraph, typename Redundant>
+void find_redundant_out_edges(LabeledGraph const& graph, node_index const u, query_context& context, Redundant const& redundant) {
+    auto const& g = graph.graph_;
+    auto& stack = context.stack_;
+    auto& frontier = context.frontier_;
+    context.begin_query(number_of_nodes(g));
+    frontier.clear();
+
+    std::size_t i = 0;
+    for (auto const v : successors(g, u)) {
+        if (context.is_visited(v)) {
+            redundant(i++, v);
+            continue;
+        }
+
+        std::swap(stack, frontier);
+        auto reachable = false;
+        while (!stack.empty()) {
+            auto const n = stack.back();
+            stack.pop_back();
+
+            auto const answer = check_labels(graph, n, v);
+            if (answer == label_answer::reachable) {
+                // n and the rest of the stack are not expanded, the next successors check them again
+                frontier.push_back(n);
+                reachable = true;
+                break;
+            }
+            if (answer == label_answer::unreachable) {
+                frontier.push_back(n);
+                continue;
+            }
+
+            auto const first_pushed = stack.size();
+            for (auto const w : successors(g, n)) {
+                if (context.is_visited(w)) continue;
+                context.visit(w);
+                prefetch_labels(graph, w);
+                stack.push_back(w);
+            }
+            // the first successor has to be on top of the stack
+            std::reverse(stack.begin() + first_pushed, stack.end());
+        }
+        frontier.insert(frontier.end(), stack.begin(), stack.end());
+        stack.clear();
+
+        if (reachable) {
+            redundant(i++, v);
+            continue;
+        }
+        // v is a witness of the following successors
+        context.visit(v);
+        prefetch_labels(graph, v);
+        frontier.push_back(v);
+        ++i;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "graphs.h"
+#include "BFL.h"
+#include "csrGraph.h"
+#include "dagUtil.h"
+#include "queryContext.h"
+#include "reachabilitySearch.h"
+#include "redundancyCheck.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * a long lived index that answers whether single edges (u, v) of a graph are redundant, i.e. implied by a path from u
+ * to v over other edges, without reducing the whole graph. it owns the graph with its edges in topological order, the
+ * topological order and the BFL labels. the graph is kept on the heap, so the labels still refer to it after the index is moved.
+ * the queries only read the index, so it can be shared by several threads as long as each thread queries with its own
+ * context of make_query_context
+ */
+template <size_t hash_range, typename Graph = csr_graph>
+struct redundancy_index {
+    std::unique_ptr<Graph> graph_;
+    std::vector<node_index> to_;
+    labeled_graph<hash_range, Graph> labeled_graph_;
+
+    redundancy_index(std::unique_ptr<Graph> graph, std::vector<node_index> to, labeled_graph<hash_range, Graph>&& labeled_graph)
+        : graph_(std::move(graph)), to_(std::move(to)), labeled_graph_(std::move(labeled_graph)) {}
+
+    long number_of_nodes() const {
+        return graphs::number_of_nodes(*graph_);
+    }
+
+    query_context make_query_context() const {
+        return query_context(number_of_nodes());
+    }
+
+    // whether u reaches v without the edge (u, v), which for an edge of the graph means that it is redundant
+    bool is_redundant(node_index const u, node_index const v, query_context& context) const {
+        return witness(u, v, context).has_value();
+    }
+
+    // a successor of u that reaches v or a predecessor of v that u reaches, nothing if (u, v) is not redundant
+    std::optional<node_index> witness(node_index const u, node_index const v, query_context& context) const {
+        return find_witness(labeled_graph_, u, v, to_, context, search_direction::bidirectional);
+    }
+};
+
+// the graph is copied unless it is passed as rvalue, its edges are sorted in topological order
+template <size_t hash_range, typename Graph, bucket_source Buckets>
+redundancy_index<hash_range, Graph> build_redundancy_index(Graph graph, Buckets const& policy, long const d, long const number_of_interval_labelings = 0) {
+    auto sorted = std::make_unique<Graph>(std::move(graph));
+    auto [to, to_reverse] = get_topological_order(*sorted);
+    set_edges_in_topological_order(*sorted, to);
+    auto labels = build_labeled_graph<hash_range>(*sorted, policy, d, number_of_interval_labelings);
+    return redundancy_index<hash_range, Graph>(std::move(sorted), std::move(to), std::move(labels));
+}
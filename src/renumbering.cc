@@ -0,0 +1,177 @@
+#include "renumbering.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <stack>
+#include <stdexcept>
+
+#include "dagUtil.h"
+
+std::vector<node_index> dfs_order(csr_graph const& g) {
+    std::vector<node_index> order;
+    order.reserve(g.number_of_nodes());
+    std::vector<bool> visited(g.number_of_nodes(), false);
+    std::stack<node_index> to_visit;
+
+    // start at all nodes without incoming edges, the edges are pushed in reverse so they are visited in their order
+    for (long source = 0; source < g.number_of_nodes(); ++source) {
+        if (in_degree(g, source) != 0) continue;
+        to_visit.push(source);
+        while (!to_visit.empty()) {
+            auto const n = to_visit.top();
+            to_visit.pop();
+            if (visited[n]) continue;
+
+            visited[n] = true;
+            order.push_back(n);
+            auto const outgoing_edges = g.outgoing_edges(n);
+            for (auto it = outgoing_edges.rbegin(); it != outgoing_edges.rend(); ++it) {
+                if (!visited[*it]) to_visit.push(*it);
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<node_index> bfs_order(csr_graph const& g) {
+    std::vector<node_index> order;
+    order.reserve(g.number_of_nodes());
+    std::vector<bool> visited(g.number_of_nodes(), false);
+    std::queue<node_index> to_visit;
+
+    for (long source = 0; source < g.number_of_nodes(); ++source) {
+        if (in_degree(g, source) != 0) continue;
+        visited[source] = true;
+        to_visit.push(source);
+        while (!to_visit.empty()) {
+            auto const n = to_visit.front();
+            to_visit.pop();
+            order.push_back(n);
+            for (auto const m : g.outgoing_edges(n)) {
+                if (visited[m]) continue;
+                visited[m] = true;
+                to_visit.push(m);
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<node_index> rcm_order(csr_graph const& g) {
+    auto const num_of_nodes = g.number_of_nodes();
+    auto const degree = [&g](node_index const n) { return out_degree(g, n) + in_degree(g, n); };
+
+    // start each component at a node of minimal degree
+    std::vector<node_index> nodes_by_degree(num_of_nodes);
+    std::iota(nodes_by_degree.begin(), nodes_by_degree.end(), 0);
+    std::stable_sort(nodes_by_degree.begin(), nodes_by_degree.end(), [&degree](node_index const a, node_index const b) { return degree(a) < degree(b); });
+
+    std::vector<node_index> order;
+    order.reserve(num_of_nodes);
+    std::vector<bool> visited(num_of_nodes, false);
+    std::vector<node_index> neighbors;
+
+    for (auto const start : nodes_by_degree) {
+        if (visited[start]) continue;
+        visited[start] = true;
+        // order is used as the queue of the breadth first search
+        auto head = order.size();
+        order.push_back(start);
+        while (head < order.size()) {
+            auto const n = order[head++];
+            neighbors.clear();
+            for (auto const m : g.outgoing_edges(n)) {
+                if (!visited[m]) neighbors.push_back(m);
+            }
+            for (auto const m : g.incoming_edges(n)) {
+                if (!visited[m]) neighbors.push_back(m);
+            }
+            std::sort(neighbors.begin(), neighbors.end(), [&degree](node_index const a, node_index const b) { return degree(a) < degree(b); });
+            for (auto const m : neighbors) {
+                if (visited[m]) continue; // m can appear twice if it is a successor and a predecessor
+                visited[m] = true;
+                order.push_back(m);
+            }
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<node_index> compute_renumbering(csr_graph const& g, node_ordering const ordering) {
+    std::vector<node_index> order;
+    switch (ordering) {
+        case node_ordering::dfs:
+            order = dfs_order(g);
+            break;
+        case node_ordering::topological:
+            order = std::get<1>(get_topological_order(g));
+            break;
+        case node_ordering::bfs:
+            order = bfs_order(g);
+            break;
+        case node_ordering::rcm:
+            order = rcm_order(g);
+            break;
+    }
+
+    if (order.size() != static_cast<std::size_t>(g.number_of_nodes())) {
+        throw std::invalid_argument("the input graph is not a dag");
+    }
+
+    // order contains the old ids in their new order
+    return invert_renumbering(order);
+}
+
+std::vector<node_index> invert_renumbering(std::vector<node_index> const& new_id) {
+    std::vector<node_index> old_id(new_id.size());
+    for (long i = 0; i < static_cast<long>(new_id.size()); ++i) {
+        old_id[new_id[i]] = i;
+    }
+    return old_id;
+}
+
+csr_graph renumber_graph(csr_graph const& g, std::vector<node_index> const& new_id) {
+    auto const old_id = invert_renumbering(new_id);
+    csr_graph renumbered;
+    renumbered.offsets_out_.resize(g.number_of_nodes() + 1, 0);
+    renumbered.offsets_in_.resize(g.number_of_nodes() + 1, 0);
+    renumbered.targets_out_.reserve(g.number_of_edges());
+    renumbered.targets_in_.reserve(g.number_of_edges());
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        for (auto const m : g.outgoing_edges(old_id[i])) {
+            renumbered.targets_out_.push_back(new_id[m]);
+        }
+        for (auto const m : g.incoming_edges(old_id[i])) {
+            renumbered.targets_in_.push_back(new_id[m]);
+        }
+        renumbered.offsets_out_[i+1] = static_cast<long long>(renumbered.targets_out_.size());
+        renumbered.offsets_in_[i+1] = static_cast<long long>(renumbered.targets_in_.size());
+    }
+
+    return renumbered;
+}
+
+csr_graph reduce_with_renumbering(csr_graph const& g, node_ordering const ordering, csr_graph (*algorithm)(csr_graph)) {
+    auto const new_id = compute_renumbering(g, ordering);
+    auto reduced = algorithm(renumber_graph(g, new_id));
+    return renumber_graph(reduced, invert_renumbering(new_id));
+}
+
+void reduce_with_renumbering(graph& g, node_ordering const ordering, csr_graph (*algorithm)(csr_graph)) {
+    auto const reduced = reduce_with_renumbering(csr_graph(g), ordering, algorithm);
+
+    for (auto& n : g.nodes_) {
+        n.outgoing_edges_.clear();
+        n.incoming_edges_.clear();
+    }
+    g.number_of_edges_ = 0;
+    for (long i = 0; i < reduced.number_of_nodes(); ++i) {
+        for (auto const m : reduced.outgoing_edges(i)) {
+            g.add_edge(i, m);
+        }
+    }
+}
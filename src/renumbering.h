@@ -0,0 +1,32 @@
+#pragma once
+#include "graphs.h"
+#include "csrGraph.h"
+
+#include <vector>
+
+using namespace graphs;
+
+// orders in which the nodes can be renumbered before running a TR engine
+enum class node_ordering {
+    dfs,         // preorder of a depth first search from the sources
+    topological, // Kahn's order, afterwards the topological index of each node equals its id
+    bfs,         // breadth first search from the sources
+    rcm          // reverse Cuthill-McKee on the undirected graph
+};
+
+// returns the new id of each node, new_id[old id]
+std::vector<node_index> compute_renumbering(csr_graph const& g, node_ordering ordering);
+
+// returns the graph in which node u of g has the id new_id[u], the order of the edges of each node is kept
+csr_graph renumber_graph(csr_graph const& g, std::vector<node_index> const& new_id);
+
+std::vector<node_index> invert_renumbering(std::vector<node_index> const& new_id);
+
+/**
+ * renumbers g in the given ordering, so that neighbors get close ids and the label arrays are accessed with more locality,
+ * runs the algorithm (e.g. tr_o_plus) on the renumbered graph and maps the result back to the original ids
+ */
+csr_graph reduce_with_renumbering(csr_graph const& g, node_ordering ordering, csr_graph (*algorithm)(csr_graph));
+
+// the same for graph, the edges of g are replaced by the ones of the reduced graph
+void reduce_with_renumbering(graph& g, node_ordering ordering, csr_graph (*algorithm)(csr_graph));
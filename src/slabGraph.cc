@@ -0,0 +1,107 @@
+#include "slabGraph.h"
+
+namespace graphs {
+
+slab_graph::slab_graph(csr_graph const& g)
+    : slab_(g.number_of_edges() * 2), twin_(g.number_of_edges() * 2), begin_(g.number_of_nodes() + 1, 0), middle_(g.number_of_nodes(), 0),
+      out_degree_(g.number_of_nodes()), in_degree_(g.number_of_nodes()), number_of_edges_(g.number_of_edges()), number_of_tombstones_(0) {
+    auto const num_of_nodes = g.number_of_nodes();
+
+    for (long i = 0; i < num_of_nodes; ++i) {
+        out_degree_[i] = graphs::out_degree(g, i);
+        in_degree_[i] = graphs::in_degree(g, i);
+        middle_[i] = begin_[i] + out_degree_[i];
+        begin_[i+1] = middle_[i] + in_degree_[i];
+    }
+
+    // copy the outgoing edges and write each edge into the next free incoming position of its target
+    std::vector<long long> next_incoming(middle_);
+    for (long i = 0; i < num_of_nodes; ++i) {
+        auto p = begin_[i];
+        for (auto const m : g.outgoing_edges(i)) {
+            auto const q = next_incoming[m]++;
+            slab_[p] = m;
+            slab_[q] = i;
+            twin_[p] = q;
+            twin_[q] = p;
+            ++p;
+        }
+    }
+}
+
+void slab_graph::remove_edge_at(long long const p) {
+    auto const q = twin_[p];
+
+    --out_degree_[slab_[q]];
+    --in_degree_[slab_[p]];
+    slab_[p] = tombstone;
+    slab_[q] = tombstone;
+    number_of_edges_ -= 1;
+    number_of_tombstones_ += 2;
+}
+
+void slab_graph::remove_edge(node_index const from, node_index const to) {
+    for (auto p = begin_[from]; p < middle_[from]; ++p) {
+        if (slab_[p] == to) {
+            remove_edge_at(p);
+            return;
+        }
+    }
+}
+
+void slab_graph::compact() {
+    if (number_of_tombstones_ == 0) return;
+
+    // new_position[p] is the position of the live entry p after compaction
+    std::vector<long long> new_position(slab_.size());
+    long long current = 0;
+    for (long i = 0; i < number_of_nodes(); ++i) {
+        auto const old_begin = begin_[i];
+        auto const old_middle = middle_[i];
+        begin_[i] = current;
+        for (auto p = old_begin; p < begin_[i+1]; ++p) {
+            if (p == old_middle) middle_[i] = current;
+            if (slab_[p] != tombstone) new_position[p] = current++;
+        }
+        if (old_middle == begin_[i+1]) middle_[i] = current;
+    }
+
+    for (long long p = 0; p < static_cast<long long>(slab_.size()); ++p) {
+        if (slab_[p] == tombstone) continue;
+        slab_[new_position[p]] = slab_[p];
+        twin_[new_position[p]] = new_position[twin_[p]];
+    }
+
+    begin_.back() = current;
+    slab_.resize(current);
+    twin_.resize(current);
+    slab_.shrink_to_fit();
+    twin_.shrink_to_fit();
+    number_of_tombstones_ = 0;
+}
+
+graph to_graph(slab_graph const& g) {
+    graph new_graph;
+    new_graph.nodes_.reserve(g.number_of_nodes());
+    new_graph.number_of_edges_ = g.number_of_edges_;
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        new_graph.nodes_.emplace_back(i);
+    }
+
+    for (long i = 0; i < g.number_of_nodes(); ++i) {
+        auto& n = new_graph.nodes_[i];
+        n.outgoing_edges_.reserve(g.out_degree_[i]);
+        n.incoming_edges_.reserve(g.in_degree_[i]);
+        for (auto const m : g.outgoing_edges(i)) {
+            n.outgoing_edges_.push_back(&new_graph.nodes_[m]);
+        }
+        for (auto const m : g.incoming_edges(i)) {
+            n.incoming_edges_.push_back(&new_graph.nodes_[m]);
+        }
+    }
+
+    return new_graph;
+}
+
+} // namespace graphs
@@ -0,0 +1,89 @@
+#pragma once
+#include "graphs.h"
+#include "csrGraph.h"
+
+#include <span>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * mutable graph whose adjacency lives in a single slab
+ * the block of node i is slab_[begin_[i]] ... slab_[begin_[i+1]-1], it starts with the outgoing edges of i
+ * followed by the incoming edges of i (starting at slab_[middle_[i]])
+ * twin_[p] is the position of the same edge in the block of the other endpoint, which allows removing an edge in O(1)
+ * by marking both of its positions as tombstone. traversals skip tombstones and compact() removes them from the slab
+ */
+struct slab_graph {
+    static constexpr node_index tombstone = static_cast<node_index>(-1);
+
+    std::vector<node_index> slab_;
+    std::vector<long long> twin_;
+    std::vector<long long> begin_;
+    std::vector<long long> middle_;
+    std::vector<long> out_degree_;
+    std::vector<long> in_degree_;
+    long long number_of_edges_;
+    long long number_of_tombstones_;
+
+    explicit slab_graph(csr_graph const& g);
+    explicit slab_graph(graph const& g) : slab_graph(csr_graph(g)) {}
+
+    long number_of_nodes() const {
+        return static_cast<long>(begin_.size()) - 1;
+    }
+
+    // the raw blocks include tombstones
+    std::span<node_index const> outgoing_block(node_index const id) const {
+        return {slab_.data() + begin_[id], slab_.data() + middle_[id]};
+    }
+
+    std::span<node_index const> incoming_block(node_index const id) const {
+        return {slab_.data() + middle_[id], slab_.data() + begin_[id+1]};
+    }
+
+    auto outgoing_edges(node_index const id) const {
+        return outgoing_block(id) | std::views::filter([](node_index const m) { return m != tombstone; });
+    }
+
+    auto incoming_edges(node_index const id) const {
+        return incoming_block(id) | std::views::filter([](node_index const m) { return m != tombstone; });
+    }
+
+    // removes the edge whose outgoing position in the slab is p in O(1), the incoming position is found by twin_[p]
+    void remove_edge_at(long long p);
+
+    // searches the edge in the block of from, prefer remove_edge_at if the position is known
+    void remove_edge(node_index from, node_index to);
+
+    // removes all tombstones from the slab
+    void compact();
+};
+
+inline long number_of_nodes(slab_graph const& g) {
+    return g.number_of_nodes();
+}
+
+inline auto successors(slab_graph const& g, node_index const id) {
+    return g.outgoing_edges(id);
+}
+
+inline auto predecessors(slab_graph const& g, node_index const id) {
+    return g.incoming_edges(id);
+}
+
+inline long out_degree(slab_graph const& g, node_index const id) {
+    return g.out_degree_[id];
+}
+
+inline long in_degree(slab_graph const& g, node_index const id) {
+    return g.in_degree_[id];
+}
+
+inline void prefetch_successors(slab_graph const& g, node_index const id) {
+    __builtin_prefetch(g.slab_.data() + g.begin_[id]);
+}
+
+graph to_graph(slab_graph const& g);
+
+} // namespace graphs
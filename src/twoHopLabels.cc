@@ -0,0 +1,87 @@
+#include "twoHopLabels.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "slabGraph.h"
+
+namespace {
+
+// appends the labels of all nodes to one array and returns the offsets of the nodes
+std::vector<long long> flatten_labels(std::vector<std::vector<std::uint32_t>>& labels, std::vector<std::uint32_t>& flat) {
+    std::vector<long long> offsets(labels.size() + 1, 0);
+    for (std::size_t n = 0; n < labels.size(); ++n) offsets[n+1] = offsets[n] + static_cast<long long>(labels[n].size());
+    flat.reserve(offsets.back());
+    for (auto& label : labels) {
+        flat.insert(flat.end(), label.begin(), label.end());
+        label = {};
+    }
+    return offsets;
+}
+
+} // namespace
+
+template <typename Graph>
+two_hop_oracle<Graph> build_two_hop_oracle(Graph const& graph) {
+    auto const num_of_nodes = number_of_nodes(graph);
+    if (static_cast<unsigned long long>(num_of_nodes) > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("the input graph has too many nodes for 32 bit landmark ranks");
+    }
+
+    std::vector<node_index> landmarks(num_of_nodes);
+    std::iota(landmarks.begin(), landmarks.end(), 0);
+    std::stable_sort(landmarks.begin(), landmarks.end(), [&graph](node_index const a, node_index const b) {
+        return (in_degree(graph, a) + 1) * (out_degree(graph, a) + 1) > (in_degree(graph, b) + 1) * (out_degree(graph, b) + 1);
+    });
+
+    std::vector<std::vector<std::uint32_t>> label_out(num_of_nodes);
+    std::vector<std::vector<std::uint32_t>> label_in(num_of_nodes);
+    std::vector<std::uint32_t> visited(num_of_nodes, 0);
+    std::vector<std::uint8_t> marked(num_of_nodes, 0); // the ranks in the label of the current landmark
+    std::vector<node_index> queue;
+    std::uint32_t epoch = 0;
+
+    // a pruned BFS from landmark in one direction: a node that the current labels already connect to the landmark is
+    // pruned together with everything behind it, all other nodes get the landmark in their label
+    auto const pruned_bfs = [&](node_index const landmark, std::uint32_t const rank, auto const& neighbors,
+                                std::vector<std::uint32_t> const& landmark_label, std::vector<std::vector<std::uint32_t>>& labels) {
+        for (auto const r : landmark_label) marked[r] = 1;
+        ++epoch;
+        queue.clear();
+        queue.push_back(landmark);
+        visited[landmark] = epoch;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            auto const n = queue[head];
+            auto const& label = labels[n];
+            if (n != landmark && std::any_of(label.begin(), label.end(), [&marked](std::uint32_t const r) { return marked[r] != 0; })) continue;
+            labels[n].push_back(rank);
+            for (auto const m : neighbors(n)) {
+                if (visited[m] == epoch) continue;
+                visited[m] = epoch;
+                queue.push_back(m);
+            }
+        }
+        for (auto const r : landmark_label) marked[r] = 0;
+    };
+
+    for (std::uint32_t rank = 0; rank < static_cast<std::uint32_t>(num_of_nodes); ++rank) {
+        auto const landmark = landmarks[rank];
+        // the landmark reaches the nodes of the forward BFS, so they get it in label_in and are pruned by label_out(landmark)
+        pruned_bfs(landmark, rank, [&graph](node_index const n) { return successors(graph, n); }, label_out[landmark], label_in);
+        pruned_bfs(landmark, rank, [&graph](node_index const n) { return predecessors(graph, n); }, label_in[landmark], label_out);
+    }
+
+    two_hop_oracle<Graph> oracle(graph);
+    oracle.offsets_out_ = flatten_labels(label_out, oracle.label_out_);
+    oracle.offsets_in_ = flatten_labels(label_in, oracle.label_in_);
+    return oracle;
+}
+
+template two_hop_oracle<graph> build_two_hop_oracle(graph const&);
+template two_hop_oracle<csr_graph> build_two_hop_oracle(csr_graph const&);
+template two_hop_oracle<slab_graph> build_two_hop_oracle(slab_graph const&);
+template two_hop_oracle<compressed_graph> build_two_hop_oracle(compressed_graph const&);
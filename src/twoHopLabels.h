@@ -0,0 +1,46 @@
+#pragma once
+#include "graphs.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace graphs;
+
+/**
+ * an exact 2-hop reachability labeling built by pruned landmark labeling: the nodes are landmarks in the order of
+ * descending (in_degree + 1) * (out_degree + 1), a node u reaches v if and only if label_out(u) and label_in(v) share
+ * a landmark. the labels hold the ranks of the landmarks, sorted ascending, in one array per direction like a csr_graph,
+ * so a query is a merge of two short sorted arrays without any search in the graph
+ */
+template <typename Graph>
+struct two_hop_oracle {
+    Graph const& graph_;
+    std::vector<long long> offsets_out_;
+    std::vector<std::uint32_t> label_out_;
+    std::vector<long long> offsets_in_;
+    std::vector<std::uint32_t> label_in_;
+
+    explicit two_hop_oracle(Graph const& graph) : graph_(graph) {}
+
+    std::size_t size_in_bytes() const {
+        return (offsets_out_.size() + offsets_in_.size()) * sizeof(long long) + (label_out_.size() + label_in_.size()) * sizeof(std::uint32_t);
+    }
+};
+
+// builds the labels with one pruned BFS per landmark and direction
+template <typename Graph>
+two_hop_oracle<Graph> build_two_hop_oracle(Graph const& graph);
+
+template <typename Graph>
+bool query_reachability(two_hop_oracle<Graph> const& oracle, node_index const u, node_index const v) {
+    auto const* out = oracle.label_out_.data() + oracle.offsets_out_[u];
+    auto const* out_end = oracle.label_out_.data() + oracle.offsets_out_[u+1];
+    auto const* in = oracle.label_in_.data() + oracle.offsets_in_[v];
+    auto const* in_end = oracle.label_in_.data() + oracle.offsets_in_[v+1];
+    while (out != out_end && in != in_end) {
+        if (*out == *in) return true;
+        if (*out < *in) ++out;
+        else ++in;
+    }
+    return false;
+}
@@ -240,4 +240,47 @@ TEST(BFL, queringIsCorrectOnLargeGeneratedGraphs) {
         }
     }
 
-}
\ No newline at end of file
+}
+
+TEST(BFL, queringSearchesLongChains) {
+    int constexpr chain_length = 20000;
+
+    // one long chain and a node that is not on it, all labels are equal, so queries to that node need to search the whole chain
+    graph g;
+    for(int i = 0; i <= chain_length; ++i) {
+        g.nodes_.emplace_back(i);
+    }
+    for(int i = 0; i + 1 < chain_length; ++i) {
+        g.add_edge(i, i + 1);
+    }
+    auto const labeled_graph = build_labeled_graph<64, graph>(g, [](node_index const) { return 0; }, 64);
+
+    ASSERT_FALSE(query_reachability(labeled_graph, 0, chain_length));
+    ASSERT_FALSE(query_reachability(labeled_graph, chain_length / 2, chain_length));
+    ASSERT_TRUE(query_reachability(labeled_graph, 0, chain_length - 1));
+    ASSERT_FALSE(query_reachability(labeled_graph, chain_length - 1, 0));
+}
+
+TEST(BFL, queringIsCorrectInEachSearchDirection) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_edges = 12000;
+    int constexpr num_of_test_nodes = 10;
+    int constexpr hash_range = 64;
+
+    set_seed(17102026);
+    auto dag = generate_graph(num_of_nodes, num_of_edges, true, true);
+    auto const labeled_graph = build_labeled_graph<hash_range, graph>(dag, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    query_context context;
+    for(int i = 0; i < num_of_test_nodes; ++i) {
+        auto const test_node = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[test_node]);
+        for(int j = 0; j < num_of_nodes; ++j) {
+            auto const reachable = reachable_nodes.contains(&dag.nodes_[j]);
+            ASSERT_EQ(query_reachability(labeled_graph, test_node, j, context, search_direction::forward), reachable);
+            ASSERT_EQ(query_reachability(labeled_graph, test_node, j, context, search_direction::bidirectional), reachable);
+            ASSERT_EQ(query_reachability(labeled_graph, j, test_node, context, search_direction::bidirectional), query_reachability(labeled_graph, j, test_node, context, search_direction::forward));
+            ASSERT_EQ(query_reachability(labeled_graph, test_node, j, context, search_direction::automatic), reachable);
+        }
+    }
+}
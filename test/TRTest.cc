@@ -6,6 +6,7 @@
 #include "TR-O-PLUS.h"
 #include "dagGenerator.h"
 #include "dagUtil.h"
+#include "twoHopLabels.h"
 
 /**
 * @brief Generates the graph from the example in the paper "One Edge at a Time: Novel Approach Towards Efficient Transitive Reduction Computation on DAGs"
@@ -173,3 +174,168 @@ TEST(TRO_PLUS, correctlyBuildsTransitiveReductionOnLargeGeneratedGraphs) {
 
     ASSERT_EQ(g, g2);
 }
+
+TEST(TRO_PLUS, correctlyBuildsTransitiveReductionWithEachHashRange) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    for (auto const hash_range : supported_hash_ranges) {
+        auto const parameters = label_parameters::for_hash_range(hash_range);
+
+        auto reduced = copy_graph(g);
+        tr_o_plus(reduced, parameters);
+        set_edges_in_topological_order(reduced, to);
+        ASSERT_EQ(reduced, expected);
+
+        for (auto reduced_csr : {tr_b(csr_graph(g), parameters), tr_o(csr_graph(g), parameters), tr_o_plus(csr_graph(g), parameters)}) {
+            auto reduced_graph = to_graph(reduced_csr);
+            set_edges_in_topological_order(reduced_graph, to);
+            ASSERT_EQ(reduced_graph, expected);
+        }
+    }
+}
+
+TEST(TRO_PLUS, correctlyBuildsTransitiveReductionWithIntervalLabelings) {
+    int constexpr number_of_nodes = 1000;
+    int constexpr number_of_edges = 5000;
+
+    set_seed(17102026);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    auto parameters = label_parameters::for_hash_range(64);
+    parameters.number_of_interval_labelings_ = 3;
+
+    auto reduced = copy_graph(g);
+    tr_o_plus(reduced, parameters);
+    set_edges_in_topological_order(reduced, to);
+    ASSERT_EQ(reduced, expected);
+
+    for (auto reduced_csr : {tr_b(csr_graph(g), parameters), tr_o(csr_graph(g), parameters), tr_o_plus(csr_graph(g), parameters)}) {
+        auto reduced_graph = to_graph(reduced_csr);
+        set_edges_in_topological_order(reduced_graph, to);
+        ASSERT_EQ(reduced_graph, expected);
+    }
+}
+
+TEST(TRO_PLUS, rejectsHashRangesThatAreNotInstantiated) {
+    auto g = generate_example_graph_tr_test();
+    ASSERT_THROW(tr_o_plus(g, label_parameters::for_hash_range(100)), std::invalid_argument);
+}
+
+TEST(TRO_PLUS, correctlyBuildsTransitiveReductionWithEachOracle) {
+    int constexpr number_of_nodes = 1000;
+    int constexpr number_of_edges = 5000;
+
+    set_seed(17102026);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    auto const check = [&](csr_graph const& reduced_csr) {
+        auto reduced_graph = to_graph(reduced_csr);
+        set_edges_in_topological_order(reduced_graph, to);
+        ASSERT_EQ(reduced_graph, expected);
+    };
+    auto const each_engine = [&](auto const& make_oracle) {
+        check(tr_b(csr_graph(g), make_oracle));
+        check(tr_o(csr_graph(g), make_oracle));
+        check(tr_o_plus(csr_graph(g), make_oracle));
+    };
+
+    each_engine([](csr_graph const& graph) { return build_labeled_graph<256>(graph, [](node_index const id) { return id % 256; }, 2560); });
+    each_engine([](csr_graph const& graph) { return closure_oracle(graph); });
+    each_engine([](csr_graph const& graph) { return interval_oracle(graph); });
+    each_engine([](csr_graph const& graph) { return dfs_oracle(graph); });
+    each_engine([](csr_graph const& graph) { return build_two_hop_oracle(graph); });
+
+    auto reduced_compressed = tr_o_plus(compressed_graph(csr_graph(g)), [](compressed_graph const& graph) { return closure_oracle(graph); });
+    check(to_csr_graph(reduced_compressed));
+}
+
+TEST(TRO_PLUS, closureOracleRejectsLargeGraphs) {
+    csr_graph g;
+    g.offsets_out_.assign(closure_oracle<csr_graph>::max_number_of_nodes + 2, 0);
+    g.offsets_in_ = g.offsets_out_;
+    ASSERT_THROW(closure_oracle<csr_graph>{g}, std::invalid_argument);
+}
+
+TEST(TRO_PLUS, correctlyBuildsTransitiveReductionWithEachRedundancyCheck) {
+    int constexpr number_of_nodes = 1000;
+    int constexpr number_of_edges = 5000;
+
+    set_seed(17102026);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    auto const check = [&](csr_graph const& reduced_csr) {
+        auto reduced_graph = to_graph(reduced_csr);
+        set_edges_in_topological_order(reduced_graph, to);
+        ASSERT_EQ(reduced_graph, expected);
+    };
+
+    for (auto const redundancy_check : {redundancy_check::per_witness, redundancy_check::per_edge, redundancy_check::per_source}) {
+        auto parameters = label_parameters::for_hash_range(64);
+        parameters.redundancy_check_ = redundancy_check;
+        check(tr_o_plus(csr_graph(g), parameters));
+        check(to_csr_graph(tr_o_plus(compressed_graph(csr_graph(g)), parameters)));
+
+        slab_graph reduced_slab(g);
+        tr_o_plus(reduced_slab, parameters);
+        auto reduced_graph = to_graph(reduced_slab);
+        set_edges_in_topological_order(reduced_graph, to);
+        ASSERT_EQ(reduced_graph, expected);
+
+        parameters.memory_budget_ = 4 * budgeted_labeled_graph<64, csr_graph>::minimal_size_in_bytes(number_of_nodes);
+        check(tr_o_plus(csr_graph(g), parameters));
+    }
+}
+
+TEST(TRO_PLUS, witnessFilterKeepsTheUndecidedWitnessesMostLikelyFirst) {
+    set_seed(17102026);
+    auto csr = csr_graph(generate_graph(1000, 5000, true));
+    auto const [to, to_reverse] = get_topological_order(csr);
+    set_edges_in_topological_order(csr, to);
+    auto const labeled_graph = build_labeled_graph<64>(csr, [](node_index const id) { return id % 64; }, 640);
+
+    query_context context;
+    for (long u = 0; u < csr.number_of_nodes(); ++u) {
+        for (auto const v : successors(csr, u)) {
+            auto const [confirmed, backward] = prefilter_witnesses(labeled_graph, u, v, to, context);
+            auto const& witnesses = context.witnesses_;
+            if (confirmed) {
+                ASSERT_EQ(witnesses.size(), 1);
+                auto const w = witnesses.front();
+                ASSERT_EQ(backward ? check_labels(labeled_graph, u, w) : check_labels(labeled_graph, w, v), label_answer::reachable);
+                continue;
+            }
+            for (std::size_t i = 0; i < witnesses.size(); ++i) {
+                auto const w = witnesses[i];
+                ASSERT_EQ(backward ? check_labels(labeled_graph, u, w) : check_labels(labeled_graph, w, v), label_answer::unknown);
+                if (i == 0) continue;
+                auto const previous = witnesses[i - 1];
+                if (backward) {
+                    ASSERT_GE(in_degree(csr, previous), in_degree(csr, w));
+                } else {
+                    auto const width = [&](node_index const n) { return dfs_interval(labeled_graph, n).finish_ - dfs_interval(labeled_graph, n).discovery_; };
+                    ASSERT_GE(width(previous), width(w));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <random>
+
+#include "batchQueries.h"
+#include "BFL.h"
+#include "budgetedLabels.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "reachabilityIndex.h"
+
+namespace {
+
+std::vector<reachability_query> random_queries(long const number_of_nodes, std::size_t const number_of_queries, std::uint64_t const seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<long> node_distribution(0, number_of_nodes - 1);
+    std::vector<reachability_query> queries;
+    queries.reserve(number_of_queries);
+    for (std::size_t i = 0; i < number_of_queries; ++i) {
+        queries.emplace_back(node_distribution(gen), node_distribution(gen));
+    }
+    return queries;
+}
+
+} // namespace
+
+TEST(batchQueries, answersEqualSingleQueries) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr hash_range = 64;
+
+    set_seed(9092024);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 12000, true, true));
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    auto queries = random_queries(num_of_nodes, 20000, 17102026);
+    queries.emplace_back(5, 5);
+
+    for (std::size_t const threads : {1, 4}) {
+        auto const results = query_reachability_batch(labeled_graph, queries, threads);
+        ASSERT_EQ(results.size(), queries.size());
+        std::size_t reachable = 0;
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            auto const [u, v] = queries[i];
+            ASSERT_EQ(results[i], query_reachability(labeled_graph, u, v));
+            reachable += results[i];
+        }
+        ASSERT_EQ(results.count(), reachable);
+        ASSERT_TRUE(results[queries.size() - 1]);
+    }
+}
+
+TEST(batchQueries, interleavedQueriesEqualSingleQueries) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr hash_range = 64;
+
+    set_seed(12092024);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 12000, true, true));
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    auto queries = random_queries(num_of_nodes, 20000, 9092024);
+    queries.emplace_back(7, 7);
+
+    for (std::size_t const lanes : {1, 3, 8}) {
+        auto const interleaved = query_reachability_interleaved(labeled_graph, queries, lanes);
+        auto const batch = query_reachability_batch(labeled_graph, queries, 2, search_direction::forward, lanes);
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            auto const [u, v] = queries[i];
+            auto const expected = query_reachability(labeled_graph, u, v);
+            ASSERT_EQ(interleaved[i], expected);
+            ASSERT_EQ(batch[i], expected);
+        }
+    }
+}
+
+TEST(batchQueries, answersBudgetedLabelsAndIndexQueries) {
+    int constexpr num_of_nodes = 2000;
+    int constexpr hash_range = 1024;
+
+    set_seed(3012025);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 8000, true, true));
+    auto const h = [](node_index const id) { return id % hash_range; };
+    auto const budgeted = build_budgeted_labeled_graph<hash_range>(csr, h, hash_range*10, budgeted_labeled_graph<hash_range, csr_graph>::minimal_size_in_bytes(num_of_nodes) * 2);
+    auto const index = build_reachability_index<hash_range>(csr, h, hash_range*10);
+    auto const queries = random_queries(num_of_nodes, 10000, 9092024);
+
+    auto const budgeted_results = query_reachability_batch(budgeted, queries, 3);
+    auto const index_results = index.reachable(queries, 3);
+    auto context = index.make_query_context();
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        auto const [u, v] = queries[i];
+        auto const expected = index.reachable(u, v, context);
+        ASSERT_EQ(budgeted_results[i], expected);
+        ASSERT_EQ(index_results[i], expected);
+    }
+}
+
+TEST(batchQueries, answersEmptyBatches) {
+    set_seed(3012025);
+    auto const csr = csr_graph(generate_graph(100, 300, true, true));
+    auto const labeled_graph = build_labeled_graph<64>(csr, [](node_index const id) { return id % 64; }, 640);
+    ASSERT_EQ(query_reachability_batch(labeled_graph, std::span<reachability_query const>()).size(), 0);
+}
+
+TEST(evaluate, batchQueries) {
+    int constexpr num_of_nodes = 100000;
+    int constexpr hash_range = 1024;
+
+    set_seed(12092024);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 500000, true, true));
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    auto const queries = random_queries(num_of_nodes, 1000000, 17102026);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::size_t reachable = 0;
+    for (auto const& [u, v] : queries) reachable += query_reachability(labeled_graph, u, v);
+    auto duration = duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+    std::cout << "single queries. TIME: " << duration.count() << "microseconds\n";
+
+    for (std::size_t const threads : {1, 2, 4, 8}) {
+        start = std::chrono::high_resolution_clock::now();
+        auto const results = query_reachability_batch(labeled_graph, queries, threads);
+        duration = duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+        std::cout << "batch queries with " << threads << " threads. TIME: " << duration.count() << "microseconds\n";
+        ASSERT_EQ(results.count(), reachable);
+    }
+
+    for (std::size_t const lanes : {4, 8, 16}) {
+        start = std::chrono::high_resolution_clock::now();
+        auto const results = query_reachability_interleaved(labeled_graph, queries, lanes);
+        duration = duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+        std::cout << "interleaved queries with " << lanes << " lanes. TIME: " << duration.count() << "microseconds\n";
+        ASSERT_EQ(results.count(), reachable);
+    }
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include "budgetedLabels.h"
+#include "csrGraph.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(budgetedLabels, queringIsCorrectForDifferentBudgets) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_edges = 12000;
+    int constexpr num_of_test_nodes = 15;
+    int constexpr hash_range = 1024;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, num_of_edges, true, true);
+    auto const csr = csr_graph(dag);
+    auto const minimal_budget = budgeted_labeled_graph<hash_range, csr_graph>::minimal_size_in_bytes(num_of_nodes);
+
+    for (auto const budget : {minimal_budget, 4 * minimal_budget, 100 * minimal_budget}) {
+        auto const labeled_graph = build_budgeted_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10, budget);
+        ASSERT_LE(labeled_graph.size_in_bytes(), budget);
+
+        for(int i = 0; i < num_of_test_nodes; ++i) {
+            auto const test_node = (i * 7919) % num_of_nodes;
+            auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[test_node]);
+
+            for(int j = 0; j < num_of_nodes; ++j) {
+                ASSERT_EQ(query_reachability(labeled_graph, test_node, j), reachable_nodes.contains(&dag.nodes_[j]));
+                ASSERT_EQ(query_reachability(labeled_graph, test_node, j, search_direction::bidirectional), reachable_nodes.contains(&dag.nodes_[j]));
+            }
+        }
+    }
+}
+
+TEST(budgetedLabels, isSmallerThanTheFullLabels) {
+    int constexpr hash_range = 1024;
+
+    set_seed(3012025);
+    auto const csr = csr_graph(generate_graph(10000, 30000, true));
+    auto const full_size = 10000 * (sizeof(interval) + 2 * label_arena<hash_range>::words_per_label * sizeof(std::uint64_t));
+    auto const labeled_graph = build_budgeted_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10, full_size / 4);
+
+    ASSERT_LE(labeled_graph.size_in_bytes(), full_size / 4);
+}
+
+TEST(budgetedLabels, rejectsTooSmallBudgets) {
+    set_seed(3012025);
+    auto const csr = csr_graph(generate_graph(100, 300, true));
+
+    ASSERT_THROW(build_budgeted_labeled_graph<1024>(csr, [](node_index const id) { return id % 1024; }, 10240, 100), std::invalid_argument);
+}
+
+TEST(budgetedLabels, trOPlusBuildsTransitiveReduction) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true, true);
+    auto const budget = budgeted_labeled_graph<1024, csr_graph>::minimal_size_in_bytes(number_of_nodes) * 2;
+    auto reduced = to_graph(tr_o_plus(csr_graph(g), budget));
+    auto reduced_compressed = to_graph(to_csr_graph(tr_o_plus(compressed_graph(csr_graph(g)), budget)));
+
+    build_tr_by_dfs(g);
+    auto const [to, to_reverse] = get_topological_order(g);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(reduced, to);
+    set_edges_in_topological_order(reduced_compressed, to);
+
+    ASSERT_EQ(reduced, g);
+    ASSERT_EQ(reduced_compressed, g);
+}
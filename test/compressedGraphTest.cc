@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+#include "compressedGraph.h"
+#include "BFL.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(compressedGraph, decodesTheEncodedRows) {
+    set_seed(3012025);
+    auto const g = generate_graph(1000, 5000, true, true);
+    auto const csr = csr_graph(g);
+    auto const compressed = compressed_graph(csr);
+
+    ASSERT_EQ(compressed.number_of_nodes(), csr.number_of_nodes());
+    ASSERT_EQ(compressed.number_of_edges_, csr.number_of_edges());
+    for(long i = 0; i < csr.number_of_nodes(); ++i) {
+        ASSERT_EQ(out_degree(compressed, i), out_degree(csr, i));
+        ASSERT_EQ(in_degree(compressed, i), in_degree(csr, i));
+    }
+    ASSERT_EQ(to_csr_graph(compressed), csr);
+}
+
+TEST(compressedGraph, isSmallerThanCsrGraph) {
+    set_seed(3012025);
+    auto const g = generate_graph(100000, 500000, true);
+    auto const csr = csr_graph(g);
+    auto const compressed = compressed_graph(csr);
+
+    auto const csr_size = (csr.offsets_out_.size() + csr.offsets_in_.size()) * sizeof(long long)
+        + (csr.targets_out_.size() + csr.targets_in_.size()) * sizeof(node_index);
+    ASSERT_LT(compressed.size_in_bytes(), csr_size);
+}
+
+TEST(compressedGraph, queringIsCorrectOnLargeGeneratedGraphs) {
+    int constexpr num_of_nodes = 5000;
+    int constexpr num_of_edges = 20000;
+    int constexpr num_of_test_nodes = 20;
+    int constexpr hash_range = 160;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, num_of_edges, true, true);
+    auto const compressed = compressed_graph(csr_graph(dag));
+    auto const labeled_graph = build_labeled_graph<hash_range>(compressed, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    for(int i = 0; i < num_of_test_nodes; ++i) {
+        auto const test_node = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[test_node]);
+
+        for(int j = 0; j < num_of_nodes; ++j) {
+            ASSERT_EQ(query_reachability(labeled_graph, test_node, j), reachable_nodes.contains(&dag.nodes_[j]));
+        }
+    }
+}
+
+TEST(compressedGraph, trOPlusBuildsTransitiveReduction) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true, true);
+    auto const reduced_compressed = tr_o_plus(compressed_graph(csr_graph(g)));
+    auto reduced = to_graph(to_csr_graph(reduced_compressed));
+
+    build_tr_by_dfs(g);
+    auto const [to, to_reverse] = get_topological_order(g);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(reduced, to);
+
+    ASSERT_EQ(reduced, g);
+}
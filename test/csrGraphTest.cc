@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include "csrGraph.h"
+#include "BFL.h"
+#include "TR-B.h"
+#include "TR-O.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(csrGraph, isCorrectlyBuiltFromGraph) {
+    set_seed(1012025);
+    auto g = generate_graph(1000, 5000, true, true);
+    auto const csr = csr_graph(g);
+
+    ASSERT_EQ(csr.number_of_nodes(), g.nodes_.size());
+    ASSERT_EQ(csr.number_of_edges(), g.number_of_edges_);
+    ASSERT_EQ(to_graph(csr), g);
+}
+
+TEST(csrGraph, incomingEdgesAreBuiltFromOutgoingEdges) {
+    set_seed(1012025);
+    auto g = generate_graph(1000, 5000, true, true);
+    auto const csr = csr_graph(g);
+    auto const rebuilt = csr_graph(csr.offsets_out_, csr.targets_out_);
+
+    for(long i = 0; i < csr.number_of_nodes(); ++i) {
+        std::vector<long> expected(csr.incoming_edges(i).begin(), csr.incoming_edges(i).end());
+        std::vector<long> actual(rebuilt.incoming_edges(i).begin(), rebuilt.incoming_edges(i).end());
+        std::ranges::sort(expected);
+        std::ranges::sort(actual);
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST(csrGraph, queringIsCorrectOnLargeGeneratedGraphs) {
+    int constexpr num_of_nodes = 5000;
+    int constexpr num_of_edges = 20000;
+    int constexpr num_of_test_nodes = 20;
+    int constexpr hash_range = 160;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, num_of_edges, true, true);
+    auto const csr = csr_graph(dag);
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](long const id) { return id % hash_range; }, hash_range*10);
+
+    for(int i = 0; i < num_of_test_nodes; ++i) {
+        auto const test_node = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[test_node]);
+
+        for(int j = 0; j < num_of_nodes; ++j) {
+            ASSERT_EQ(query_reachability(labeled_graph, test_node, j), reachable_nodes.contains(&dag.nodes_[j]));
+        }
+    }
+}
+
+void csr_transitive_reduction_is_correct(csr_graph (*algorithm)(csr_graph)) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true, true);
+    auto reduced = to_graph(algorithm(csr_graph(g)));
+
+    build_tr_by_dfs(g);
+    auto const [to, to_reverse] = get_topological_order(g);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(reduced, to);
+
+    ASSERT_EQ(reduced, g);
+}
+
+TEST(csrGraph, trBBuildsTransitiveReduction) {
+    csr_transitive_reduction_is_correct([](csr_graph g) { return tr_b(g); });
+}
+
+TEST(csrGraph, trOBuildsTransitiveReduction) {
+    csr_transitive_reduction_is_correct([](csr_graph g) { return tr_o(std::move(g)); });
+}
+
+TEST(csrGraph, trOPlusBuildsTransitiveReduction) {
+    csr_transitive_reduction_is_correct([](csr_graph g) { return tr_o_plus(std::move(g)); });
+}
@@ -19,7 +19,7 @@ TEST(dagUtil, topologicalOrderFinderThrowsErrorIfInputIsNotADag) {
     EXPECT_THROW(get_topological_order(non_dag), std::invalid_argument);
 }
 
-bool graph_is_in_topological_order(graph const& graph, std::vector<long> const& to) {
+bool graph_is_in_topological_order(graph const& graph, std::vector<node_index> const& to) {
     for(auto const& n : graph.nodes_) {
         for(auto const e : n.outgoing_edges_) {
             if(to[n.id_] >= to[e->id_]) return false;
@@ -37,7 +37,7 @@ TEST(dagUtil, findsValidTopologicalOrder) {
     set_seed(21012024);
     graph dag = generate_graph(num_of_nodes, num_of_edges, true, true);
 
-    auto fake_order = std::vector<long>(num_of_nodes);
+    auto fake_order = std::vector<node_index>(num_of_nodes);
     for(int i = 0; i<num_of_nodes; i++) {
         fake_order[i] = i;
     }
@@ -47,7 +47,7 @@ TEST(dagUtil, findsValidTopologicalOrder) {
     ASSERT_TRUE(graph_is_in_topological_order(dag, to));
 }
 
-bool all_nodes_edges_are_in_topological_order(graph const& graph, std::vector<long> const& to) {
+bool all_nodes_edges_are_in_topological_order(graph const& graph, std::vector<node_index> const& to) {
     for(auto const& n : graph.nodes_) {
         for(auto i = 0; i < static_cast<long>(n.outgoing_edges_.size()) - 1; ++i) {
             if(to[n.outgoing_edges_[i]->id_] >= to[n.outgoing_edges_[i+1]->id_]) return false;
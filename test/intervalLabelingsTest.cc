@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include "intervalLabelings.h"
+#include "BFL.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(intervalLabelings, cutsAgreeWithReachability) {
+    int constexpr num_of_nodes = 2000;
+    int constexpr num_of_test_nodes = 20;
+
+    set_seed(17102026);
+    auto const dag = generate_graph(num_of_nodes, 8000, true, true);
+    auto const csr = csr_graph(dag);
+
+    for (long k = 1; k <= 4; ++k) {
+        auto const labelings = build_interval_labelings(csr, k);
+        ASSERT_EQ(labelings.intervals_.size(), num_of_nodes * k);
+
+        long decided = 0;
+        for (int i = 0; i < num_of_test_nodes; ++i) {
+            auto const u = (i * 7919) % num_of_nodes;
+            auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[u]);
+            for (int v = 0; v < num_of_nodes; ++v) {
+                auto const answer = check_interval_labelings(labelings, u, v);
+                if (answer != 0) {
+                    ASSERT_EQ(answer > 0, reachable_nodes.contains(&dag.nodes_[v]));
+                    ++decided;
+                }
+            }
+        }
+        ASSERT_GT(decided, 0);
+    }
+}
+
+TEST(intervalLabelings, labelingsDifferInTheirChildOrder) {
+    set_seed(17102026);
+    auto const dag = generate_graph(500, 2000, true, true);
+    auto const labelings = build_interval_labelings(dag, 3);
+
+    bool differ = false;
+    for (long n = 0; n < 500 && !differ; ++n) {
+        auto const* intervals = labelings.of(n);
+        differ = intervals[0].discovery_ != intervals[1].discovery_ || intervals[1].discovery_ != intervals[2].discovery_;
+    }
+    ASSERT_TRUE(differ);
+}
+
+TEST(intervalLabelings, queringWithIntervalLabelingsIsCorrect) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_test_nodes = 10;
+    int constexpr hash_range = 64;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, 12000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10, 3);
+    ASSERT_EQ(labeled_graph.interval_labelings_.k_, 3);
+
+    for (int i = 0; i < num_of_test_nodes; ++i) {
+        auto const u = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[u]);
+        for (int v = 0; v < num_of_nodes; ++v) {
+            ASSERT_EQ(query_reachability(labeled_graph, u, v), reachable_nodes.contains(&dag.nodes_[v]));
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "labelBuckets.h"
+#include "BFL.h"
+#include "TR-O-PLUS.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+namespace {
+
+template <size_t hash_range>
+void expect_groups_share_buckets(std::vector<node_index> const& post_order, long const d, bucket_assignment const assignment) {
+    auto const groups = merge_vertices(post_order, d);
+    auto const buckets = assign_buckets<hash_range>(post_order, d, assignment);
+    ASSERT_EQ(buckets.size(), post_order.size());
+    for (auto const n : post_order) {
+        ASSERT_LT(buckets[n], hash_range);
+        ASSERT_EQ(buckets[n], buckets[groups[n]]);
+    }
+}
+
+}
+
+TEST(labelBuckets, everyPolicyAssignsOneBucketPerGroup) {
+    std::vector<node_index> post_order(10000);
+    for (long i = 0; i < 10000; ++i) post_order[i] = (i * 7919) % 10000;
+
+    for (auto const assignment : {bucket_assignment::murmur, bucket_assignment::multiply_shift, bucket_assignment::balanced}) {
+        expect_groups_share_buckets<64>(post_order, 640, assignment);
+        expect_groups_share_buckets<1024>(post_order, 10240, assignment);
+        expect_groups_share_buckets<2048>(post_order, 500, assignment);
+    }
+}
+
+TEST(labelBuckets, hashPolicyIsCalledOncePerGroup) {
+    std::vector<node_index> post_order(1000);
+    for (long i = 0; i < 1000; ++i) post_order[i] = 999 - i;
+
+    long calls = 0;
+    auto const buckets = assign_buckets<64>(post_order, 100, [&calls](node_index const id) { ++calls; return id % 64; });
+    ASSERT_EQ(calls, 100);
+    ASSERT_EQ(buckets[999], 999 % 64);
+}
+
+TEST(labelBuckets, balancedBucketsHoldTheSameNumberOfNodes) {
+    std::vector<node_index> post_order(20000);
+    for (long i = 0; i < 20000; ++i) post_order[i] = i;
+
+    // 10239 groups of one node and a last group of 9761 nodes, which goes to the one bucket with only 9 nodes
+    auto const buckets = assign_buckets<1024>(post_order, 10240, balanced_buckets{});
+    std::vector<long> population(1024, 0);
+    for (auto const bucket : buckets) ++population[bucket];
+    std::sort(population.begin(), population.end());
+    ASSERT_EQ(population.back(), 9 + 9761);
+    ASSERT_EQ(population[0], 10);
+    ASSERT_EQ(population[1022], 10);
+
+    // groups of 31 nodes are placed round robin
+    auto const round_robin = assign_buckets<64>(post_order, 640, balanced_buckets{});
+    for (long i = 0; i < 640; ++i) ASSERT_EQ(round_robin[i * 31 + 5], i % 64);
+}
+
+TEST(labelBuckets, enginesReduceWithEachBucketAssignment) {
+    set_seed(17102026);
+    auto g = generate_graph(3000, 12000, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    for (auto const assignment : {bucket_assignment::murmur, bucket_assignment::multiply_shift, bucket_assignment::balanced}) {
+        auto parameters = label_parameters::for_hash_range(256);
+        parameters.bucket_assignment_ = assignment;
+        auto reduced = to_graph(tr_o_plus(csr_graph(g), parameters));
+        set_edges_in_topological_order(reduced, to);
+        ASSERT_EQ(reduced, expected);
+
+        parameters.memory_budget_ = budgeted_labeled_graph<256, csr_graph>::minimal_size_in_bytes(3000) * 4;
+        auto budgeted = to_graph(tr_o_plus(csr_graph(g), parameters));
+        set_edges_in_topological_order(budgeted, to);
+        ASSERT_EQ(budgeted, expected);
+    }
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include <bitset>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "labelArena.h"
+#include "labelKernels.h"
+
+namespace {
+
+std::vector<label_kernel> supported_kernels() {
+    std::vector<label_kernel> kernels;
+    for (auto const kernel : {label_kernel::scalar, label_kernel::avx2, label_kernel::avx512}) {
+        if (is_supported(kernel)) kernels.push_back(kernel);
+    }
+    return kernels;
+}
+
+char const* kernel_name(label_kernel const kernel) {
+    switch (kernel) {
+        case label_kernel::avx2: return "avx2";
+        case label_kernel::avx512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+// the supersets contain their subsets, so each test has to look at all words
+template <size_t hash_range>
+void benchmark_kernels(std::size_t const number_of_labels, long const number_of_tests) {
+    auto constexpr words = label_arena<hash_range>::words_per_label;
+    std::mt19937_64 gen(3012025);
+    std::vector<std::uint64_t> subsets(number_of_labels * words);
+    std::vector<std::uint64_t> supersets(number_of_labels * words);
+    std::vector<std::bitset<hash_range>> subset_bitsets(number_of_labels);
+    std::vector<std::bitset<hash_range>> superset_bitsets(number_of_labels);
+    for (std::size_t i = 0; i < subsets.size(); ++i) {
+        subsets[i] = gen() & gen();
+        supersets[i] = subsets[i] | gen();
+    }
+    for (std::size_t l = 0; l < number_of_labels; ++l) {
+        for (std::size_t bit = 0; bit < hash_range; ++bit) {
+            subset_bitsets[l][bit] = (subsets[l * words + bit / 64] >> (bit % 64)) & 1;
+            superset_bitsets[l][bit] = (supersets[l * words + bit / 64] >> (bit % 64)) & 1;
+        }
+    }
+
+    long passed = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (long t = 0; t < number_of_tests; ++t) {
+        auto const l = t % number_of_labels;
+        auto const m = (t * 7) % number_of_labels;
+        passed += (subset_bitsets[l] & superset_bitsets[l]) == subset_bitsets[l] && (subset_bitsets[m] & superset_bitsets[m]) == subset_bitsets[m];
+    }
+    auto duration = duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+    std::cout << "subset tests bitset hash_range " << hash_range << ". TIME: " << duration.count() << "microseconds\n";
+    ASSERT_EQ(passed, number_of_tests);
+
+    auto const previous = get_label_kernel();
+    for (auto const kernel : supported_kernels()) {
+        set_label_kernel(kernel);
+        passed = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (long t = 0; t < number_of_tests; ++t) {
+            auto const l = t % number_of_labels;
+            auto const m = (t * 7) % number_of_labels;
+            passed += labels_are_subsets(&subsets[l * words], &supersets[l * words], &subsets[m * words], &supersets[m * words], words);
+        }
+        duration = duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+        std::cout << "subset tests " << kernel_name(kernel) << " hash_range " << hash_range << ". TIME: " << duration.count() << "microseconds\n";
+        ASSERT_EQ(passed, number_of_tests);
+    }
+    set_label_kernel(previous);
+}
+
+} // namespace
+
+TEST(labelKernels, kernelsAgreeWithScalarTest) {
+    std::mt19937_64 gen(9092024);
+    auto const previous = get_label_kernel();
+
+    for (std::size_t words = 1; words <= 40; ++words) {
+        for (int test = 0; test < 200; ++test) {
+            std::vector<std::uint64_t> out_subset(words), out_superset(words), in_subset(words), in_superset(words);
+            for (std::size_t i = 0; i < words; ++i) {
+                out_subset[i] = gen() & gen() & gen();
+                in_subset[i] = gen() & gen() & gen();
+                out_superset[i] = out_subset[i] | gen();
+                in_superset[i] = in_subset[i] | gen();
+            }
+            // violate one of the tests in a random word in most of the tests
+            auto const violated_word = gen() % words;
+            switch (test % 3) {
+                case 0: out_subset[violated_word] |= 1; out_superset[violated_word] &= ~std::uint64_t{1}; break;
+                case 1: in_subset[violated_word] |= 1; in_superset[violated_word] &= ~std::uint64_t{1}; break;
+                default: break;
+            }
+
+            set_label_kernel(label_kernel::scalar);
+            auto const expected = labels_are_subsets(out_subset.data(), out_superset.data(), in_subset.data(), in_superset.data(), words);
+            for (auto const kernel : supported_kernels()) {
+                set_label_kernel(kernel);
+                ASSERT_EQ(labels_are_subsets(out_subset.data(), out_superset.data(), in_subset.data(), in_superset.data(), words), expected);
+            }
+        }
+    }
+    set_label_kernel(previous);
+}
+
+TEST(labelKernels, rejectsUnsupportedKernels) {
+    for (auto const kernel : {label_kernel::avx2, label_kernel::avx512}) {
+        if (!is_supported(kernel)) {
+            ASSERT_THROW(set_label_kernel(kernel), std::invalid_argument);
+        }
+    }
+    ASSERT_TRUE(is_supported(best_label_kernel()));
+}
+
+TEST(evaluate, labelKernels) {
+    benchmark_kernels<64>(4096, 10000000);
+    benchmark_kernels<128>(4096, 10000000);
+    benchmark_kernels<256>(4096, 10000000);
+    benchmark_kernels<512>(4096, 10000000);
+    benchmark_kernels<1024>(4096, 10000000);
+    benchmark_kernels<2048>(4096, 10000000);
+}
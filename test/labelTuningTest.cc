@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "labelTuning.h"
+#include "TR-O-PLUS.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(labelTuning, choosesOneOfTheMeasuredCandidates) {
+    set_seed(17102026);
+    auto const csr = csr_graph(generate_graph(20000, 80000, true, true));
+
+    tuning_options options;
+    options.number_of_sources_ = 500;
+    auto const report = tune_label_parameters(csr, options);
+    ASSERT_EQ(report.number_of_sources_, options.number_of_sources_);
+    // at least two hash ranges and the other values of d for the best one
+    ASSERT_GE(report.candidates_.size(), 2 + options.d_factors_.size() - 1);
+    for (auto const& candidate : report.candidates_) {
+        ASSERT_GE(candidate.pruning_rate_, 0.0);
+        ASSERT_LE(candidate.pruning_rate_, 1.0);
+    }
+    auto const chosen = std::ranges::find_if(report.candidates_, [&](tuning_candidate const& candidate) {
+        return candidate.hash_range_ == report.chosen_.hash_range_ && candidate.d_ == report.chosen_.d_;
+    });
+    ASSERT_NE(chosen, report.candidates_.end());
+    // no candidate that counts as equally fast prunes more
+    auto const time = [](tuning_candidate const& candidate) { return candidate.build_microseconds_ + candidate.check_microseconds_; };
+    auto const fastest = time(*std::ranges::min_element(report.candidates_, {}, time));
+    ASSERT_LE(time(*chosen), fastest * (1.0 + options.time_tolerance_));
+    for (auto const& candidate : report.candidates_) {
+        if (time(candidate) <= fastest * (1.0 + options.time_tolerance_)) {
+            ASSERT_LE(candidate.pruning_rate_, chosen->pruning_rate_);
+        }
+    }
+    ASSERT_FALSE(report.chosen_.auto_tune_);
+
+    std::ostringstream printed;
+    print_tuning_report(report, printed);
+    auto const chosen_line = "chosen: hash_range " + std::to_string(report.chosen_.hash_range_) + " d " + std::to_string(report.chosen_.d_) + "\n";
+    ASSERT_NE(printed.str().find(chosen_line), std::string::npos);
+    ASSERT_NE(printed.str().find(" microseconds, check "), std::string::npos);
+}
+
+TEST(labelTuning, respectsTheMemoryLimit) {
+    set_seed(17102026);
+    auto const csr = csr_graph(generate_graph(5000, 20000, true, true));
+
+    tuning_options options;
+    options.d_factors_ = {10};
+    options.memory_limit_ = 5000 * (sizeof(interval) + 2 * 128 / 8);
+    auto const report = tune_label_parameters(csr, options);
+    ASSERT_LE(report.chosen_.hash_range_, 128);
+    for (auto const& candidate : report.candidates_) {
+        ASSERT_LE(candidate.memory_in_bytes_, options.memory_limit_);
+    }
+
+    options.memory_limit_ = 1;
+    ASSERT_THROW(tune_label_parameters(csr, options), std::invalid_argument);
+
+    // by default no candidate needs more memory than the labels of the engines without tuning
+    auto const default_report = tune_label_parameters(csr, tuning_options{});
+    for (auto const& candidate : default_report.candidates_) {
+        ASSERT_LE(candidate.hash_range_, label_parameters{}.hash_range_);
+    }
+}
+
+TEST(labelTuning, enginesReduceWithTheTunedParameters) {
+    set_seed(3012025);
+    auto g = generate_graph(1000, 5000, true);
+    auto expected = copy_graph(g);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    tuning_report report;
+    label_parameters parameters;
+    parameters.auto_tune_ = true;
+    parameters.tuning_report_ = &report;
+    auto reduced = to_graph(tr_o_plus(csr_graph(g), parameters));
+    set_edges_in_topological_order(reduced, to);
+    ASSERT_EQ(reduced, expected);
+
+    // the engine tells which parameters it chose
+    ASSERT_FALSE(report.candidates_.empty());
+    ASSERT_TRUE(std::ranges::any_of(report.candidates_, [&](tuning_candidate const& candidate) {
+        return candidate.hash_range_ == report.chosen_.hash_range_ && candidate.d_ == report.chosen_.d_;
+    }));
+}
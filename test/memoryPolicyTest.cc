@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <sched.h>
+
+#include "memoryPolicy.h"
+#include "TR-B.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(memoryPolicy, parsesPolicyDescriptions) {
+    ASSERT_EQ(parse_memory_policy(""), memory_policy{});
+    ASSERT_EQ(parse_memory_policy("thp"), (memory_policy{page_policy::transparent_huge_pages, numa_policy::none, false}));
+    ASSERT_EQ(parse_memory_policy("hugetlb,interleave,pin"), (memory_policy{page_policy::explicit_huge_pages, numa_policy::interleave, true}));
+    ASSERT_EQ(parse_memory_policy("standard,first_touch"), (memory_policy{page_policy::standard, numa_policy::first_touch, false}));
+    ASSERT_THROW(parse_memory_policy("thp,huge"), std::invalid_argument);
+}
+
+TEST(memoryPolicy, allocatesAlignedZeroedMemoryWithEachPolicy) {
+    auto const previous = get_memory_policy();
+    for (auto const* description : {"standard", "thp", "hugetlb", "interleave", "thp,first_touch"}) {
+        set_memory_policy(parse_memory_policy(description));
+        for (std::size_t const size : {1ul, 4096ul, 3000000ul}) {
+            auto* memory = static_cast<std::uint8_t*>(allocate_memory(size));
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(memory) % 64, 0);
+            for (std::size_t i = 0; i < size; i += 997) {
+                ASSERT_EQ(memory[i], 0);
+            }
+            memory[size - 1] = 1;
+            deallocate_memory(memory);
+        }
+    }
+    set_memory_policy(previous);
+}
+
+TEST(memoryPolicy, trOPlusBuildsTheSameReductionWithEachPolicy) {
+    set_seed(12092024);
+    auto const g = generate_graph(1000, 20000, true, true);
+    auto const expected = tr_o_plus(csr_graph(g));
+
+    auto const previous = get_memory_policy();
+    for (auto const* description : {"thp", "hugetlb,interleave", "thp,first_touch"}) {
+        set_memory_policy(parse_memory_policy(description));
+        ASSERT_EQ(tr_o_plus(csr_graph(g)), expected);
+    }
+    set_memory_policy(previous);
+}
+
+TEST(memoryPolicy, enginesRestoreTheAffinityOfTheCallingThread) {
+    cpu_set_t before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+
+    set_seed(17102026);
+    auto const g = generate_graph(500, 5000, true, true);
+    auto const previous = get_memory_policy();
+    set_memory_policy(parse_memory_policy("pin"));
+    {
+        scoped_thread_pin const pin(0);
+        if (pin.pinned()) {
+            cpu_set_t pinned;
+            ASSERT_EQ(sched_getaffinity(0, sizeof(pinned), &pinned), 0);
+            ASSERT_EQ(CPU_COUNT(&pinned), 1);
+        }
+    }
+    auto const reduced = tr_o_plus(csr_graph(g));
+    ASSERT_EQ(tr_b(csr_graph(g)).number_of_edges(), reduced.number_of_edges());
+    set_memory_policy(previous);
+
+    cpu_set_t after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    ASSERT_TRUE(CPU_EQUAL(&before, &after));
+}
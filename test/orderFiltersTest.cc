@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+
+#include "orderFilters.h"
+#include "BFL.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(orderFilters, onlyDenyUnreachableNodes) {
+    int constexpr num_of_nodes = 2000;
+    int constexpr num_of_test_nodes = 20;
+
+    set_seed(17102026);
+    auto const dag = generate_graph(num_of_nodes, 8000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const [to, to_reverse] = get_topological_order(csr);
+    auto const filters = build_order_filters(csr, to_reverse);
+
+    long denied = 0;
+    for (int i = 0; i < num_of_test_nodes; ++i) {
+        auto const u = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[u]);
+        for (int v = 0; v < num_of_nodes; ++v) {
+            if (check_order_filters(filters.bounds_[u], filters.bounds_[v]) != order_filter::none) {
+                ASSERT_FALSE(reachable_nodes.contains(&dag.nodes_[v]));
+                ++denied;
+            }
+        }
+    }
+    ASSERT_GT(denied, 0);
+}
+
+TEST(orderFilters, boundsOfAChain) {
+    int constexpr num_of_nodes = 5;
+    graph g;
+    for (long i = 0; i < num_of_nodes; ++i) g.nodes_.emplace_back(i);
+    for (long i = 0; i + 1 < num_of_nodes; ++i) g.add_edge(i, i + 1);
+    g.nodes_.emplace_back(num_of_nodes); // an isolated node
+
+    auto const [to, to_reverse] = get_topological_order(g);
+    auto const filters = build_order_filters(g, to_reverse);
+    for (long i = 0; i < num_of_nodes; ++i) {
+        ASSERT_EQ(filters.bounds_[i].level_, i);
+        ASSERT_EQ(filters.bounds_[i].max_reachable_, to[num_of_nodes - 1]);
+        ASSERT_EQ(filters.bounds_[i].min_reaching_, to[0]);
+    }
+    ASSERT_EQ(check_order_filters(filters.bounds_[3], filters.bounds_[1]), order_filter::topological);
+    ASSERT_EQ(check_order_filters(filters.bounds_[1], filters.bounds_[3]), order_filter::none);
+    ASSERT_EQ(check_order_filters(filters.bounds_[2], filters.bounds_[2]), order_filter::none);
+    ASSERT_NE(check_order_filters(filters.bounds_[num_of_nodes], filters.bounds_[0]), order_filter::none);
+}
+
+TEST(orderFilters, countersSumUpToTheNumberOfQueries) {
+    int constexpr num_of_nodes = 1000;
+    int constexpr hash_range = 64;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, 4000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const labeled_graph = build_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    query_context context;
+    auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[0]);
+    for (int v = 0; v < num_of_nodes; ++v) {
+        ASSERT_EQ(query_reachability(labeled_graph, 0, v, context), reachable_nodes.contains(&dag.nodes_[v]));
+    }
+    auto const& counters = context.counters_;
+    ASSERT_EQ(counters.topological_ + counters.level_ + counters.bounds_ + counters.searched_, num_of_nodes);
+    ASSERT_GT(counters.topological_, 0);
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "queryServer.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "redundancyIndex.h"
+
+namespace {
+
+std::vector<query_request> random_requests(long const number_of_nodes, std::size_t const number_of_requests, std::uint64_t const seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<long> node_distribution(0, number_of_nodes - 1);
+    std::vector<query_request> requests;
+    requests.reserve(number_of_requests);
+    for (std::size_t i = 0; i < number_of_requests; ++i) {
+        auto const kind = i % 3 == 0 ? query_kind::redundancy : query_kind::reachability;
+        requests.push_back({kind, 0, node_distribution(gen), node_distribution(gen)});
+    }
+    return requests;
+}
+
+template <typename Index>
+std::uint8_t expected_answer(Index const& index, query_request const& request, query_context& context) {
+    if (request.kind_ == query_kind::redundancy) return index.is_redundant(request.u_, request.v_, context);
+    return query_reachability(index.labeled_graph_, request.u_, request.v_, context);
+}
+
+// the cpu time of the whole process, user and system
+std::chrono::microseconds process_cpu_time() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+std::string socket_path(std::string const& name) {
+    return (std::filesystem::temp_directory_path() / (name + "-" + std::to_string(::getpid()) + ".sock")).string();
+}
+
+} // namespace
+
+TEST(queryServer, batcherAnswersRequestsOfSeveralThreads) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_threads = 4;
+    int constexpr hash_range = 64;
+
+    set_seed(17102026);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 12000, true, true));
+    auto const index = build_redundancy_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    query_batcher batcher(index, {3, 64, std::chrono::microseconds(100)});
+
+    std::vector<std::thread> threads;
+    std::vector<long> wrong_answers(num_of_threads, 0);
+    for (int t = 0; t < num_of_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto context = index.make_query_context();
+            auto const requests = random_requests(num_of_nodes, 5000, t);
+            // single requests and whole blocks are coalesced into the same batches
+            for (std::size_t first = 0; first < requests.size(); first += 500) {
+                auto const block = std::span(requests).subspan(first, 500);
+                auto const answers = t % 2 == 0 ? batcher.answer(block) : std::vector<std::uint8_t>{};
+                for (std::size_t i = 0; i < block.size(); ++i) {
+                    auto const answer = t % 2 == 0 ? answers[i] : batcher.answer(block.subspan(i, 1))[0];
+                    if (answer != expected_answer(index, block[i], context)) ++wrong_answers[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (auto const wrong : wrong_answers) {
+        ASSERT_EQ(wrong, 0);
+    }
+    auto const statistics = batcher.statistics();
+    ASSERT_EQ(statistics.queries_, num_of_threads * 5000);
+    ASSERT_LT(statistics.batches_, statistics.queries_);
+    ASSERT_LE(statistics.p50_microseconds_, statistics.p99_microseconds_);
+    ASSERT_GT(statistics.queries_per_second_, 0);
+
+    batcher.reset_statistics();
+    ASSERT_EQ(batcher.statistics().queries_, 0);
+}
+
+TEST(queryServer, answersClientsOverUnixSocket) {
+    int constexpr num_of_nodes = 2000;
+    int constexpr num_of_clients = 3;
+    int constexpr hash_range = 128;
+
+    set_seed(3012025);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 8000, true, true));
+    auto const index = build_redundancy_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    query_server server(index, socket_path("queryServerTest"), {2, 128, std::chrono::microseconds(50)});
+
+    std::vector<std::thread> clients;
+    std::vector<long> wrong_answers(num_of_clients, 0);
+    for (int c = 0; c < num_of_clients; ++c) {
+        clients.emplace_back([&, c] {
+            query_client client(server.path());
+            auto context = index.make_query_context();
+            // more requests than fit into one chunk of the client or one read of the server
+            auto const requests = random_requests(num_of_nodes, 10000, 100 + c);
+            auto const answers = client.query(requests);
+            for (std::size_t i = 0; i < requests.size(); ++i) {
+                if (answers[i] != expected_answer(index, requests[i], context)) ++wrong_answers[c];
+            }
+        });
+    }
+    for (auto& client : clients) client.join();
+
+    for (auto const wrong : wrong_answers) {
+        ASSERT_EQ(wrong, 0);
+    }
+    ASSERT_EQ(server.statistics().queries_, num_of_clients * 10000);
+
+    query_client client(server.path());
+    std::vector<query_request> const invalid{{query_kind::reachability, 0, -1, 5}, {query_kind::redundancy, 0, 0, num_of_nodes},
+                                             {static_cast<query_kind>(7), 0, 0, 1}, {query_kind::reachability, 0, 3, 3}};
+    ASSERT_EQ(client.query(invalid), std::vector<std::uint8_t>({invalid_query_answer, invalid_query_answer, invalid_query_answer, 1}));
+
+    auto const path = server.path();
+    server.stop();
+    ASSERT_FALSE(std::filesystem::exists(path));
+    ASSERT_THROW(query_client{path}, std::system_error);
+}
+
+TEST(queryServer, acceptorWaitsForFreeFileDescriptors) {
+    int constexpr num_of_nodes = 500;
+    int constexpr hash_range = 64;
+
+    set_seed(17102026);
+    auto const csr = csr_graph(generate_graph(num_of_nodes, 2000, true, true));
+    auto const index = build_redundancy_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+    query_server server(index, socket_path("queryServerFileDescriptorTest"), {1, 64, std::chrono::microseconds(50)});
+
+    // every file descriptor but one is taken, the client gets the last one, so the server cannot accept its connection
+    rlimit previous{};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &previous), 0);
+    rlimit limited = previous;
+    limited.rlim_cur = std::min<rlim_t>(previous.rlim_cur, 256);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limited), 0);
+    std::vector<int> taken;
+    for (auto fd = ::dup(0); fd >= 0; fd = ::dup(0)) taken.push_back(fd);
+    auto const exhausted = errno == EMFILE;
+    ::close(taken.back());
+    taken.pop_back();
+    query_client client(server.path());
+
+    // the acceptor sleeps between its attempts instead of spinning
+    auto const cpu_before = process_cpu_time();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto const cpu_time = process_cpu_time() - cpu_before;
+
+    for (auto const fd : taken) ::close(fd);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &previous), 0);
+    ASSERT_TRUE(exhausted);
+    ASSERT_LT(cpu_time, std::chrono::milliseconds(100));
+
+    // once descriptors are free again, the connection is accepted and answered
+    std::vector<query_request> const requests{{query_kind::reachability, 0, 3, 3}};
+    ASSERT_EQ(client.query(requests), std::vector<std::uint8_t>({1}));
+}
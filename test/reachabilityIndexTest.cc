@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <thread>
+
+#include "reachabilityIndex.h"
+#include "budgetedLabels.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(reachabilityIndex, queringIsCorrectFromSeveralThreads) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_edges = 12000;
+    int constexpr num_of_threads = 4;
+    int constexpr num_of_test_nodes_per_thread = 5;
+    int constexpr hash_range = 160;
+
+    set_seed(9092024);
+    auto const dag = generate_graph(num_of_nodes, num_of_edges, true, true);
+    auto const csr = csr_graph(dag);
+    auto const index = build_reachability_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    std::vector<std::thread> threads;
+    std::vector<long> wrong_answers(num_of_threads, 0);
+    for (int t = 0; t < num_of_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto context = index.make_query_context();
+            for (int i = 0; i < num_of_test_nodes_per_thread; ++i) {
+                auto const test_node = ((t * num_of_test_nodes_per_thread + i) * 7919) % num_of_nodes;
+                auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[test_node]);
+                for (int j = 0; j < num_of_nodes; ++j) {
+                    if (index.reachable(test_node, j, context) != reachable_nodes.contains(&dag.nodes_[j])) ++wrong_answers[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (auto const wrong : wrong_answers) {
+        ASSERT_EQ(wrong, 0);
+    }
+}
+
+TEST(reachabilityIndex, contextSurvivesEpochWrapAround) {
+    int constexpr num_of_nodes = 500;
+    int constexpr hash_range = 64;
+
+    set_seed(3012025);
+    auto const dag = generate_graph(num_of_nodes, 2000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const index = build_reachability_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    auto context = index.make_query_context();
+    context.epoch_ = std::numeric_limits<std::uint32_t>::max() - 2;
+    auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[0]);
+    for (int j = 0; j < num_of_nodes; ++j) {
+        ASSERT_EQ(index.reachable(0, j, context), reachable_nodes.contains(&dag.nodes_[j]));
+    }
+}
+
+TEST(reachabilityIndex, wrapsBudgetedLabels) {
+    int constexpr num_of_nodes = 1000;
+    int constexpr hash_range = 1024;
+
+    set_seed(3012025);
+    auto const dag = generate_graph(num_of_nodes, 4000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const budget = budgeted_labeled_graph<hash_range, csr_graph>::minimal_size_in_bytes(num_of_nodes) * 2;
+    reachability_index index(build_budgeted_labeled_graph<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10, budget));
+
+    auto context = index.make_query_context();
+    auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[1]);
+    for (int j = 0; j < num_of_nodes; ++j) {
+        ASSERT_EQ(index.reachable(1, j, context), reachable_nodes.contains(&dag.nodes_[j]));
+    }
+}
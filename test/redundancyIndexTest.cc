@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+
+#include "redundancyIndex.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+namespace {
+
+// the edges of the transitive reduction of g as (u, v)
+std::set<std::tuple<node_index, node_index>> reduced_edges(graph& g) {
+    auto reduced = copy_graph(g);
+    build_tr_by_dfs(reduced);
+    std::set<std::tuple<node_index, node_index>> edges;
+    for (auto const& n : reduced.nodes_) {
+        for (auto const w : n.outgoing_edges_) edges.emplace(n.id_, w->id_);
+    }
+    return edges;
+}
+
+} // namespace
+
+TEST(redundancyIndex, answersEachEdgeFromSeveralThreads) {
+    int constexpr num_of_nodes = 2000;
+    int constexpr num_of_threads = 4;
+    int constexpr hash_range = 64;
+
+    set_seed(17102026);
+    auto dag = generate_graph(num_of_nodes, 10000, true, true);
+    auto const reduced = reduced_edges(dag);
+    auto const csr = csr_graph(dag);
+    auto const index = build_redundancy_index<hash_range>(csr, [](node_index const id) { return id % hash_range; }, hash_range*10);
+
+    std::vector<std::thread> threads;
+    std::vector<long> wrong_answers(num_of_threads, 0);
+    for (int t = 0; t < num_of_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto context = index.make_query_context();
+            for (long u = t; u < num_of_nodes; u += num_of_threads) {
+                for (auto const v : successors(csr, u)) {
+                    if (index.is_redundant(u, v, context) == reduced.contains({u, v})) ++wrong_answers[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (auto const wrong : wrong_answers) {
+        ASSERT_EQ(wrong, 0);
+    }
+}
+
+TEST(redundancyIndex, witnessesAreOnAnotherPath) {
+    int constexpr num_of_nodes = 1000;
+    int constexpr hash_range = 128;
+
+    set_seed(3012025);
+    auto dag = generate_graph(num_of_nodes, 5000, true, true);
+    auto const reduced = reduced_edges(dag);
+    auto const csr = csr_graph(dag);
+    auto index = build_redundancy_index<hash_range>(compressed_graph(csr), [](node_index const id) { return id % hash_range; }, hash_range*10);
+    auto const moved = std::move(index); // the labels refer to the graph of the index
+
+    auto context = moved.make_query_context();
+    for (long u = 0; u < num_of_nodes; ++u) {
+        for (auto const v : successors(csr, u)) {
+            auto const w = moved.witness(u, v, context);
+            ASSERT_EQ(w.has_value(), !reduced.contains({u, v}));
+            if (!w) continue;
+            auto const is_successor = std::ranges::find(successors(csr, u), *w) != successors(csr, u).end();
+            auto const is_predecessor = std::ranges::find(predecessors(csr, v), *w) != predecessors(csr, v).end();
+            ASSERT_TRUE(*w != u && *w != v);
+            ASSERT_TRUE((is_successor && query_reachability(moved.labeled_graph_, *w, v)) || (is_predecessor && query_reachability(moved.labeled_graph_, u, *w)));
+        }
+    }
+
+    // for any other pair (u, x) it answers whether u reaches x over a path of at least two edges
+    for (long u = 0; u < 50; ++u) {
+        std::unordered_set<node const*> reachable_over_two_edges;
+        for (auto const w : dag.nodes_[u].outgoing_edges_) {
+            reachable_over_two_edges.merge(find_all_reachable_nodes(*w, false));
+        }
+        for (long x = 0; x < num_of_nodes; ++x) {
+            ASSERT_EQ(moved.is_redundant(u, x, context), reachable_over_two_edges.contains(&dag.nodes_[x]));
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+
+#include "renumbering.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+std::vector<node_ordering> const all_orderings = {node_ordering::dfs, node_ordering::topological, node_ordering::bfs, node_ordering::rcm};
+
+TEST(renumbering, computesAPermutation) {
+    set_seed(4012025);
+    auto const g = csr_graph(generate_graph(1000, 5000, true, true));
+
+    for(auto const ordering : all_orderings) {
+        auto new_id = compute_renumbering(g, ordering);
+        std::sort(new_id.begin(), new_id.end());
+        for(long i = 0; i < g.number_of_nodes(); ++i) {
+            ASSERT_EQ(new_id[i], i);
+        }
+    }
+}
+
+TEST(renumbering, topologicalRenumberingSortsTheIds) {
+    set_seed(4012025);
+    auto const g = csr_graph(generate_graph(1000, 5000, true, true));
+    auto const renumbered = renumber_graph(g, compute_renumbering(g, node_ordering::topological));
+
+    for(long i = 0; i < renumbered.number_of_nodes(); ++i) {
+        for(auto const m : renumbered.outgoing_edges(i)) {
+            ASSERT_LT(i, m);
+        }
+    }
+}
+
+TEST(renumbering, renumberingBackRestoresTheGraph) {
+    set_seed(4012025);
+    auto const g = csr_graph(generate_graph(1000, 5000, true, true));
+
+    for(auto const ordering : all_orderings) {
+        auto const new_id = compute_renumbering(g, ordering);
+        ASSERT_EQ(renumber_graph(renumber_graph(g, new_id), invert_renumbering(new_id)), g);
+    }
+}
+
+TEST(renumbering, trOPlusBuildsTransitiveReduction) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto original = generate_graph(number_of_nodes, number_of_edges, true, true);
+    auto expected = copy_graph(original);
+    build_tr_by_dfs(expected);
+    auto const [to, to_reverse] = get_topological_order(expected);
+    set_edges_in_topological_order(expected, to);
+
+    for(auto const ordering : all_orderings) {
+        auto g = copy_graph(original);
+        reduce_with_renumbering(g, ordering, tr_o_plus);
+        set_edges_in_topological_order(g, to);
+        ASSERT_EQ(g, expected);
+    }
+}
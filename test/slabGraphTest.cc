@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include "slabGraph.h"
+#include "TR-O-PLUS.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(slabGraph, isCorrectlyBuiltFromGraph) {
+    set_seed(2012025);
+    auto g = generate_graph(1000, 5000, true, true);
+    auto const slab = slab_graph(g);
+
+    ASSERT_EQ(slab.number_of_nodes(), g.nodes_.size());
+    ASSERT_EQ(slab.number_of_edges_, g.number_of_edges_);
+    for(long long p = 0; p < static_cast<long long>(slab.slab_.size()); ++p) {
+        ASSERT_EQ(slab.twin_[slab.twin_[p]], p);
+    }
+
+    // the incoming edges are ordered by their source, so compare after sorting both
+    auto const [to, to_reverse] = get_topological_order(g);
+    auto converted = to_graph(slab);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(converted, to);
+    ASSERT_EQ(converted, g);
+}
+
+TEST(slabGraph, removedEdgesAreSkippedAndCompacted) {
+    set_seed(2012025);
+    auto g = generate_graph(1000, 5000, true, true);
+    auto slab = slab_graph(g);
+
+    // remove every third edge from the slab and from the graph
+    for(long i = 0; i < slab.number_of_nodes(); ++i) {
+        for(auto p = slab.begin_[i]; p < slab.middle_[i]; p += 3) {
+            g.remove_edge(i, slab.slab_[p]);
+            slab.remove_edge_at(p);
+        }
+    }
+    ASSERT_EQ(slab.number_of_edges_, g.number_of_edges_);
+    for(long i = 0; i < slab.number_of_nodes(); ++i) {
+        ASSERT_EQ(out_degree(slab, i), g.nodes_[i].outgoing_edges_.size());
+        ASSERT_EQ(in_degree(slab, i), g.nodes_[i].incoming_edges_.size());
+        ASSERT_EQ(std::ranges::distance(successors(slab, i)), out_degree(slab, i));
+    }
+
+    slab.compact();
+    ASSERT_EQ(slab.number_of_tombstones_, 0);
+    ASSERT_EQ(slab.slab_.size(), 2 * g.number_of_edges_);
+    for(long long p = 0; p < static_cast<long long>(slab.slab_.size()); ++p) {
+        ASSERT_EQ(slab.twin_[slab.twin_[p]], p);
+    }
+
+    auto const [to, to_reverse] = get_topological_order(g);
+    auto converted = to_graph(slab);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(converted, to);
+    ASSERT_EQ(converted, g);
+}
+
+TEST(slabGraph, trOPlusBuildsTransitiveReduction) {
+    int number_of_nodes = 1000;
+    int number_of_edges = 20000;
+
+    set_seed(12092024);
+    auto g = generate_graph(number_of_nodes, number_of_edges, true, true);
+    auto slab = slab_graph(g);
+    tr_o_plus(slab);
+    ASSERT_EQ(slab.number_of_tombstones_, 0);
+    auto reduced = to_graph(slab);
+
+    build_tr_by_dfs(g);
+    auto const [to, to_reverse] = get_topological_order(g);
+    set_edges_in_topological_order(g, to);
+    set_edges_in_topological_order(reduced, to);
+
+    ASSERT_EQ(reduced, g);
+}
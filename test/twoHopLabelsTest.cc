@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+
+#include "twoHopLabels.h"
+#include "compressedGraph.h"
+#include "csrGraph.h"
+#include "dagGenerator.h"
+#include "dagUtil.h"
+
+TEST(twoHopLabels, queringIsCorrect) {
+    int constexpr num_of_nodes = 3000;
+    int constexpr num_of_test_nodes = 20;
+
+    set_seed(17102026);
+    auto const dag = generate_graph(num_of_nodes, 12000, true, true);
+    auto const csr = csr_graph(dag);
+    auto const oracle = build_two_hop_oracle(csr);
+
+    for (int i = 0; i < num_of_test_nodes; ++i) {
+        auto const u = (i * 7919) % num_of_nodes;
+        auto const reachable_nodes = find_all_reachable_nodes(dag.nodes_[u]);
+        for (int v = 0; v < num_of_nodes; ++v) {
+            ASSERT_EQ(query_reachability(oracle, u, v), reachable_nodes.contains(&dag.nodes_[v]));
+        }
+    }
+}
+
+TEST(twoHopLabels, labelsAreSortedAndContainEveryNode) {
+    set_seed(3012025);
+    auto const compressed = compressed_graph(csr_graph(generate_graph(1000, 5000, true, true)));
+    auto const oracle = build_two_hop_oracle(compressed);
+
+    for (long n = 0; n < 1000; ++n) {
+        ASSERT_TRUE(std::is_sorted(oracle.label_out_.begin() + oracle.offsets_out_[n], oracle.label_out_.begin() + oracle.offsets_out_[n+1]));
+        ASSERT_TRUE(std::is_sorted(oracle.label_in_.begin() + oracle.offsets_in_[n], oracle.label_in_.begin() + oracle.offsets_in_[n+1]));
+        ASSERT_TRUE(query_reachability(oracle, n, n));
+    }
+    ASSERT_EQ(oracle.size_in_bytes(), 2 * 1001 * sizeof(long long) + (oracle.label_out_.size() + oracle.label_in_.size()) * sizeof(std::uint32_t));
+}